@@ -7,9 +7,14 @@
 #include "hal/hal.h"
 #include "health/health.h"
 #include "../events/event_bus.h"
+#include "../profiler/profiler.h"
+#include "../scheduler/scheduler.h"
 #include "comms/slave_link.h"
 #include "comms/radio_link.h"
 #include "control/drive_controller.h"
+#include "diagnostics/journal.h"
+#include "diagnostics/latency_trace.h"
+#include "diagnostics/slave_telemetry.h"
 #include "logging/session_logger.h"
 #include "network/control_server.h"
 #include "network/wifi_manager.h"
@@ -16,8 +16,11 @@
 #include "config/build_config.h"
 
 #include <algorithm>
+#include <atomic>
+#include <mutex>
 
 #include "TankRC.h"
+#include "core/snapshot.h"
 
 #if TANKRC_ENABLE_NETWORK
 #include "network/remote_console.h"
@@ -31,18 +34,24 @@ static Features::SoundFx sound;
 #endif
 static Comms::RadioLink radio;
 static Config::RuntimeConfig runtimeConfig = Config::makeDefaultConfig();
+// runtimeConfig is edited by the serial console on the loop task and by web handlers and
+// the telnet console on the network task. Both hold this around command handling, and
+// anything that copies the config out takes it too. Recursive because handlers call
+// applyRuntimeConfig() with it held. The control task never takes it.
+static std::recursive_mutex configMutex;
 static Storage::ConfigStore configStore;
 #if TANKRC_ENABLE_NETWORK
 static Network::WifiManager wifiManager;
 static Network::ControlServer controlServer;
 static Network::RemoteConsole remoteConsole;
 static bool wifiInitialized = false;
-static bool networkActive = false;
+static std::atomic<bool> networkActive{false};
+static std::atomic<bool> wifiLinked{false};
 static Time::NtpClock ntpClock;
 static Logging::SessionLogger sessionLogger;
 static unsigned long lastLogMs = 0UL;
-#else
-static unsigned long lastLogMs = 0UL;
+static TaskHandle_t networkTaskHandle = nullptr;
+static std::atomic<bool> networkConfigPending{false};
 #endif
 
 static Comms::CommandPacket currentPacket{};
@@ -51,28 +60,56 @@ static bool outputsEnabled = false;
 static Comms::RcStatusMode lastMode = Comms::RcStatusMode::Active;
 static bool lastRcLinked = true;
 static bool batteryLow = false;
-static float latestBattery = 0.0F;
+static std::atomic<float> latestBattery{0.0F};
 static bool rcHealthy = true;
+static bool rcDegraded = false;
 static bool batteryHealthy = true;
 static bool wifiHealthy = true;
-
-struct Task {
-    void (*fn)();
-    std::uint32_t intervalMs;
-    std::uint32_t lastRunMs;
-};
+static bool eventsHealthy = true;
+static bool slaveHealthy = true;
+static bool slaveDegraded = false;
+static bool slaveCompatible = true;
+
+// Control pipeline on core 1 above the Arduino loop task; networking on core 0. The two
+// sides only meet through snapshots and atomics, so a slow HTTP request cannot delay a
+// control cycle. The serial console stays in loop().
+constexpr BaseType_t kControlCore = 1;
+constexpr BaseType_t kNetworkCore = 0;
+constexpr UBaseType_t kControlPriority = 3;
+constexpr UBaseType_t kNetworkPriority = 1;
+constexpr std::uint32_t kTaskStackBytes = 8192;
+constexpr std::uint32_t kNetworkPollMs = 2;
+constexpr std::uint32_t kUiPollMs = 20;
+static TaskHandle_t controlTaskHandle = nullptr;
+static std::atomic<bool> controlConfigPending{false};
+// The control task runs from its own copy of the config. Console and web handlers edit
+// runtimeConfig; applyRuntimeConfig() stages a copy that the control task takes between
+// cycles, skipping a cycle rather than blocking if a handover is being written.
+static Config::RuntimeConfig controlConfig{};
+static Config::RuntimeConfig stagedControlConfig{};
+static std::mutex stagedConfigMutex;  // taken after configMutex, never before
+static Core::Snapshot<Comms::CommandPacket> packetSnapshot;
 
 void taskReadInputs();
 void taskControl();
+void taskSlaveLink();
 void taskOutputs();
 void taskHousekeeping();
 
-Task tasks[] = {
-    {taskReadInputs, 5, 0},
-    {taskControl, 5, 0},
-    {taskOutputs, 5, 0},
-    {taskHousekeeping, 100, 0},
+// Same 5 ms period for the control chain; priorities keep input -> control -> slave link ->
+// outputs in order when they come due together. The slave link runs every 1 ms so the
+// command stream can go up to 1 kHz. Housekeeping is the event bus's only consumer and
+// publishes the latency histograms for the console and web API.
+const Scheduler::TaskConfig kTasks[] = {
+    {"inputs", taskReadInputs, 5000, 4, 1000},
+    {"control", taskControl, 5000, 3, 1000},
+    {"slave link", taskSlaveLink, 1000, 2, 300},
+    {"outputs", taskOutputs, 5000, 1, 1000},
+    {"housekeeping", taskHousekeeping, 100000, 0, 5000},
 };
+// Re-check pending config at least this often.
+constexpr std::uint32_t kMaxIdleSleepUs = 5000;
+static Scheduler::Scheduler scheduler;
 
 void updateHealthState() {
     using namespace Health;
@@ -80,6 +117,16 @@ void updateHealthState() {
         setStatus(HealthCode::LowBattery, "Battery low");
     } else if (!rcHealthy) {
         setStatus(HealthCode::RcSignalLost, "RC link lost");
+    } else if (!slaveCompatible) {
+        setStatus(HealthCode::SlaveProtocolMismatch, "Slave protocol mismatch");
+    } else if (!slaveHealthy) {
+        setStatus(HealthCode::SlaveLinkLost, "Slave link lost");
+    } else if (!eventsHealthy) {
+        setStatus(HealthCode::EventOverflow, "Critical events dropped");
+    } else if (rcDegraded) {
+        setStatus(HealthCode::RcLinkDegraded, "RC link degraded");
+    } else if (slaveDegraded) {
+        setStatus(HealthCode::SlaveLinkDegraded, "Slave link degraded");
     } else if (!wifiHealthy) {
         setStatus(HealthCode::WifiDisconnected, "Wi-Fi disconnected");
     } else {
@@ -87,34 +134,61 @@ void updateHealthState() {
     }
 }
 #if FEATURE_EVENT_LOG
-void handleEventLog(const Events::Event& event) {
-    Serial.print(F("[EVT] "));
-    switch (event.type) {
-        case Events::EventType::RcSignalLost:
-            Serial.println(F("RC signal lost"));
-            break;
-        case Events::EventType::RcSignalRestored:
-            Serial.println(F("RC signal restored"));
-            break;
-        case Events::EventType::DriveModeChanged:
-            Serial.printf("Drive mode -> %ld\n", static_cast<long>(event.i1));
-            break;
-        case Events::EventType::LowBattery:
-            Serial.printf("Battery low: %.2f V\n", event.f1);
-            break;
-        case Events::EventType::BatteryRecovered:
-            Serial.printf("Battery recovered: %.2f V\n", event.f1);
-            break;
-        case Events::EventType::ObstacleAhead:
-            Serial.printf("Obstacle detected (%.2f)\n", event.f1);
-            break;
-        default:
-            break;
-    }
+void logRcSignalLost(const Events::RcSignalLost&, std::uint32_t) {
+    Serial.println(F("[EVT] RC signal lost"));
+}
+
+void logRcSignalRestored(const Events::RcSignalRestored&, std::uint32_t) {
+    Serial.println(F("[EVT] RC signal restored"));
+}
+
+void logDriveModeChanged(const Events::DriveModeChanged& event, std::uint32_t) {
+    Serial.printf("[EVT] Drive mode -> %ld\n", static_cast<long>(event.mode));
+}
+
+void logLowBattery(const Events::LowBattery& event, std::uint32_t) {
+    Serial.printf("[EVT] Battery low: %.2f V\n", event.voltage);
 }
+
+void logBatteryRecovered(const Events::BatteryRecovered& event, std::uint32_t) {
+    Serial.printf("[EVT] Battery recovered: %.2f V\n", event.voltage);
+}
+
+void logObstacleAhead(const Events::ObstacleAhead& event, std::uint32_t) {
+    Serial.printf("[EVT] Obstacle detected (%.2f)\n", event.level);
+}
+
 #endif  // FEATURE_EVENT_LOG
 
+template <typename Topic>
+using Journaled = Events::On<Topic, Diagnostics::Journal::recordTopic<Topic>>;
+
+// Every topic lands in the incident journal; FEATURE_EVENT_LOG adds the Serial lines.
+using EventRoutes = Events::Dispatcher<Journaled<Events::DriveModeChanged>,
+                                       Journaled<Events::RcSignalLost>,
+                                       Journaled<Events::RcSignalRestored>,
+                                       Journaled<Events::LowBattery>,
+                                       Journaled<Events::BatteryRecovered>,
+                                       Journaled<Events::TipOverDetected>,
+                                       Journaled<Events::ObstacleAhead>
+#if FEATURE_EVENT_LOG
+                                       ,
+                                       Events::On<Events::RcSignalLost, logRcSignalLost>,
+                                       Events::On<Events::RcSignalRestored, logRcSignalRestored>,
+                                       Events::On<Events::DriveModeChanged, logDriveModeChanged>,
+                                       Events::On<Events::LowBattery, logLowBattery>,
+                                       Events::On<Events::BatteryRecovered, logBatteryRecovered>,
+                                       Events::On<Events::ObstacleAhead, logObstacleAhead>
+#endif
+                                       >;
+
 void applyRuntimeConfig();
+void applyControlConfig();
+void controlTaskMain(void* arg);
+#if TANKRC_ENABLE_NETWORK
+void applyNetworkConfig();
+void networkTaskMain(void* arg);
+#endif
 
 void setup() {
     Serial.begin(115200);
@@ -135,9 +209,7 @@ void setup() {
     Hal::begin(runtimeConfig);
     rcHealthy = batteryHealthy = wifiHealthy = true;
     Health::setStatus(Health::HealthCode::Ok, "Startup");
-#if FEATURE_EVENT_LOG
-    Events::subscribe(handleEventLog);
-#endif
+    EventRoutes::begin();
     applyRuntimeConfig();
     Serial.println(F("[BOOT] Runtime config applied"));
 
@@ -150,6 +222,7 @@ void setup() {
 #else
         .sound = nullptr,
 #endif
+        .radio = &radio,
     };
     UI::begin(uiContext, applyRuntimeConfig);
     Serial.println(F("[BOOT] Serial UI ready"));
@@ -159,7 +232,7 @@ void setup() {
 
 #if TANKRC_ENABLE_NETWORK
     if (runtimeConfig.features.wifiEnabled) {
-        controlServer.begin(&wifiManager, &runtimeConfig, &configStore, applyRuntimeConfig, &sessionLogger);
+        controlServer.begin(&wifiManager, &runtimeConfig, &configStore, applyRuntimeConfig, &sessionLogger, &radio);
         Serial.println(F("[BOOT] Control server online"));
         remoteConsole.begin();
         Serial.println(F("[BOOT] Remote console online (telnet 2323)"));
@@ -171,14 +244,92 @@ void setup() {
 #else
     Serial.println(F("[BOOT] Network stack disabled (TANKRC_ENABLE_NETWORK=0)"));
 #endif
+
+    for (const auto& task : kTasks) {
+        scheduler.add(task);
+    }
+    xTaskCreatePinnedToCore(controlTaskMain, "control", kTaskStackBytes, nullptr, kControlPriority, &controlTaskHandle, kControlCore);
+#if TANKRC_ENABLE_NETWORK
+    xTaskCreatePinnedToCore(networkTaskMain, "network", kTaskStackBytes, nullptr, kNetworkPriority, &networkTaskHandle, kNetworkCore);
+#endif
+}
+
+void controlTaskMain(void*) {
+    scheduler.start();
+    for (;;) {
+        if (controlConfigPending.load()) {
+            std::unique_lock<std::mutex> lock(stagedConfigMutex, std::try_to_lock);
+            if (lock.owns_lock() && controlConfigPending.exchange(false)) {
+                controlConfig = stagedControlConfig;
+                lock.unlock();
+                applyControlConfig();
+            }
+        }
+        scheduler.runDue();
+        scheduler.sleepUntilNext(kMaxIdleSleepUs);
+    }
+}
+
+#if TANKRC_ENABLE_NETWORK
+void logSession() {
+    if (!sessionLogger.enabled()) {
+        return;
+    }
+    const unsigned long nowMs = Hal::millis32();
+    if (lastLogMs != 0 && nowMs - lastLogMs < 200) {
+        return;
+    }
+    lastLogMs = nowMs;
+    const Comms::CommandPacket packet = packetSnapshot.read();
+    Logging::LogEntry entry{};
+    entry.epoch = ntpClock.now();
+    entry.timeMs = nowMs;
+    entry.steering = packet.drive.turn;
+    entry.throttle = packet.drive.throttle;
+    entry.hazard = packet.hazard;
+    entry.mode = packet.status;
+    entry.battery = latestBattery;
+    const auto telemetry = Diagnostics::slaveTelemetry();
+    entry.slaveSampleMs = telemetry.sampledMs[static_cast<std::size_t>(Comms::SlaveProtocol::TelemetryGroup::Motors)];
+    entry.leftTarget = telemetry.motors.leftTarget;
+    entry.leftOutput = telemetry.motors.leftOutput;
+    entry.rightTarget = telemetry.motors.rightTarget;
+    entry.rightOutput = telemetry.motors.rightOutput;
+    entry.slaveUptimeMs = telemetry.system.uptimeMs;
+    entry.slaveI2cErrors = telemetry.i2c.pcaErrors + telemetry.i2c.pcfErrors;
+    sessionLogger.log(entry);
 }
 
+void networkTaskMain(void*) {
+    for (;;) {
+        if (networkConfigPending.exchange(false)) {
+            applyNetworkConfig();
+        }
+        if (networkActive) {
+            wifiManager.loop();
+            const bool connected = wifiManager.isConnected();
+            ntpClock.update(connected);
+            wifiLinked = connected && !wifiManager.isApMode();
+            {
+                std::lock_guard<std::recursive_mutex> lock(configMutex);
+                controlServer.loop();
+                remoteConsole.loop();
+            }
+            logSession();
+        } else {
+            wifiLinked = false;
+        }
+        vTaskDelay(pdMS_TO_TICKS(kNetworkPollMs));
+    }
+}
+#endif
+
 void taskReadInputs() {
     currentPacket = radio.poll();
     Network::Overrides overrides{};
 #if TANKRC_ENABLE_NETWORK
     if (networkActive) {
-        currentPacket.wifiConnected = wifiManager.isConnected() && !wifiManager.isApMode();
+        currentPacket.wifiConnected = wifiLinked;
         overrides = controlServer.getOverrides();
     } else {
         currentPacket.wifiConnected = false;
@@ -194,12 +345,14 @@ void taskReadInputs() {
     }
 
     if (lastRcLinked && !currentPacket.rcLinked) {
-        Events::publish({Events::EventType::RcSignalLost, Hal::millis32()});
+        Events::publish(Events::RcSignalLost{}, Hal::millis32());
     } else if (!lastRcLinked && currentPacket.rcLinked) {
-        Events::publish({Events::EventType::RcSignalRestored, Hal::millis32()});
+        Events::publish(Events::RcSignalRestored{}, Hal::millis32());
     }
     lastRcLinked = currentPacket.rcLinked;
     rcHealthy = currentPacket.rcLinked;
+    rcDegraded = currentPacket.linkQuality < controlConfig.rc.failsafe.degradedQuality;
+    Health::setRcLinkQuality(currentPacket.linkQuality);
 
 #if TANKRC_ENABLE_NETWORK
     wifiHealthy = !networkActive || currentPacket.wifiConnected;
@@ -219,18 +372,24 @@ void taskControl() {
         driveCommand.throttle *= 0.5F;
         driveCommand.turn *= 0.5F;
     }
+    // Console tests run with the RC locked on the bench, so they override after the lock.
+    const UI::TestOverride test = UI::testOverride();
+    if (test.drive) {
+        driveCommand.throttle = test.throttle;
+        driveCommand.turn = test.turn;
+    }
     driveController.setCommand(driveCommand);
     if (currentPacket.status != lastMode) {
-        Events::publish({Events::EventType::DriveModeChanged, Hal::millis32(), static_cast<std::int32_t>(currentPacket.status)});
+        Events::publish(Events::DriveModeChanged{static_cast<std::int32_t>(currentPacket.status)}, Hal::millis32());
         lastMode = currentPacket.status;
     }
     const float obstacleLevel = std::min(currentPacket.auxChannel5, currentPacket.auxChannel6);
-    if (runtimeConfig.features.ultrasonicEnabled && obstacleLevel < 0.2F) {
-        Events::publish({Events::EventType::ObstacleAhead, Hal::millis32(), 0, obstacleLevel});
+    if (controlConfig.features.ultrasonicEnabled && obstacleLevel < 0.2F) {
+        Events::publish(Events::ObstacleAhead{obstacleLevel}, Hal::millis32());
     }
     pendingLighting = {};
-    pendingLighting.ultrasonicLeft = runtimeConfig.features.ultrasonicEnabled ? currentPacket.auxChannel5 : 1.0F;
-    pendingLighting.ultrasonicRight = runtimeConfig.features.ultrasonicEnabled ? currentPacket.auxChannel6 : 1.0F;
+    pendingLighting.ultrasonicLeft = controlConfig.features.ultrasonicEnabled ? currentPacket.auxChannel5 : 1.0F;
+    pendingLighting.ultrasonicRight = controlConfig.features.ultrasonicEnabled ? currentPacket.auxChannel6 : 1.0F;
     pendingLighting.status = static_cast<std::uint8_t>(currentPacket.status);
     if (currentPacket.hazard) {
         pendingLighting.flags |= Comms::SlaveProtocol::LightingHazard;
@@ -242,7 +401,7 @@ void taskControl() {
         pendingLighting.flags |= Comms::SlaveProtocol::LightingWifiLinked;
     }
     outputsEnabled = currentPacket.status != Comms::RcStatusMode::Locked;
-    const bool lightingInstalled = runtimeConfig.features.lightsEnabled;
+    const bool lightingInstalled = controlConfig.features.lightsEnabled;
     const bool hazardActive = lightingInstalled && currentPacket.hazard;
     const bool lightEnable = lightingInstalled && outputsEnabled && currentPacket.lightingState;
     const bool lightingEffective = lightEnable || hazardActive;
@@ -250,12 +409,15 @@ void taskControl() {
         pendingLighting.flags |= Comms::SlaveProtocol::LightingEnabled;
     }
     driveController.setLightingCommand(pendingLighting);
-    driveController.update();
 #if FEATURE_SOUND
-    sound.update(outputsEnabled && currentPacket.soundState);
+    sound.update(test.sound ? test.soundOn : outputsEnabled && currentPacket.soundState);
 #endif
 }
 
+void taskSlaveLink() {
+    driveController.update();
+}
+
 void taskOutputs() {
 #if TANKRC_ENABLE_NETWORK
     if (networkActive) {
@@ -266,6 +428,8 @@ void taskOutputs() {
         state.lighting = (pendingLighting.flags & Comms::SlaveProtocol::LightingEnabled) != 0;
         state.mode = currentPacket.status;
         state.rcLinked = currentPacket.rcLinked;
+        state.rcQuality = currentPacket.linkQuality;
+        state.rcFailsafe = currentPacket.failsafe;
         state.wifiLinked = currentPacket.wifiConnected;
         state.ultrasonicLeft = currentPacket.auxChannel5;
         state.ultrasonicRight = currentPacket.auxChannel6;
@@ -274,67 +438,89 @@ void taskOutputs() {
     }
 #endif
 
-    latestBattery = driveController.readBatteryVoltage();
-    if (!batteryLow && latestBattery < 11.0F) {
+    const float battery = driveController.readBatteryVoltage();
+    latestBattery = battery;
+    if (!batteryLow && battery < 11.0F) {
         batteryLow = true;
-        Events::publish({Events::EventType::LowBattery, Hal::millis32(), 0, latestBattery});
-    } else if (batteryLow && latestBattery > 11.5F) {
+        Events::publish(Events::LowBattery{battery}, Hal::millis32());
+    } else if (batteryLow && battery > 11.5F) {
         batteryLow = false;
-        Events::publish({Events::EventType::BatteryRecovered, Hal::millis32(), 0, latestBattery});
+        Events::publish(Events::BatteryRecovered{battery}, Hal::millis32());
     }
     batteryHealthy = !batteryLow;
+    const auto slaveLink = Diagnostics::linkQuality();
+    slaveHealthy = slaveLink.online;
+    slaveDegraded = slaveLink.degraded;
+    const auto protocol = Diagnostics::linkProtocol();
+    // Still waiting on a Hello reply counts as compatible until the slave is judged too old.
+    slaveCompatible =
+        protocol.compatible || (protocol.pending && protocol.result == Comms::SlaveProtocol::HelloResult::Ok);
     updateHealthState();
 
-#if TANKRC_ENABLE_NETWORK
-    if (networkActive && sessionLogger.enabled()) {
-        const unsigned long nowMs = Hal::millis32();
-        if (lastLogMs == 0 || nowMs - lastLogMs >= 200) {
-            lastLogMs = nowMs;
-            Logging::LogEntry entry{};
-            entry.epoch = ntpClock.now();
-            entry.steering = currentPacket.drive.turn;
-            entry.throttle = currentPacket.drive.throttle;
-            entry.hazard = currentPacket.hazard;
-            entry.mode = currentPacket.status;
-            entry.battery = latestBattery;
-            sessionLogger.log(entry);
-        }
-    }
-#endif
+    packetSnapshot.write(currentPacket);
 }
 
 void taskHousekeeping() {
-    Events::process();
-    UI::update();
+    EventRoutes::process();
+    Diagnostics::publishLatency();
+    const Events::Stats eventStats = Events::stats();
+    const auto& critical = eventStats.lanes[static_cast<std::size_t>(Events::Priority::Critical)];
+    const auto& normal = eventStats.lanes[static_cast<std::size_t>(Events::Priority::Normal)];
+    Health::setEventBackpressure(critical.dropped, normal.dropped, critical.coalesced + normal.coalesced);
+    eventsHealthy = critical.dropped == 0;
 }
 
 void loop() {
-#if TANKRC_ENABLE_NETWORK
-    if (networkActive) {
-        wifiManager.loop();
-        ntpClock.update(wifiManager.isConnected());
-        controlServer.loop();
-        remoteConsole.loop();
-    }
-#endif
-    if (UI::isWizardActive()) {
-        Core::serviceWatchdog();
-        Hal::delayMs(1);
-        return;
-    }
-    const std::uint32_t now = Hal::millis32();
-    for (auto& task : tasks) {
-        if (now - task.lastRunMs >= task.intervalMs) {
-            task.lastRunMs = now;
-            task.fn();
-        }
+    {
+        std::lock_guard<std::recursive_mutex> lock(configMutex);
+        UI::update();
     }
     Core::serviceWatchdog();
-    Hal::delayMs(1);
+    Hal::delayMs(kUiPollMs);
 }
 
 void applyRuntimeConfig() {
+    // Each half runs on the task that owns its objects. During setup or from the owning task
+    // itself it is applied inline; otherwise it is handed over and picked up on that task's
+    // next cycle.
+    std::lock_guard<std::recursive_mutex> configLock(configMutex);
+    const TaskHandle_t caller = xTaskGetCurrentTaskHandle();
+    if (!controlTaskHandle || caller == controlTaskHandle) {
+        controlConfig = runtimeConfig;
+        applyControlConfig();
+    } else {
+        std::lock_guard<std::mutex> lock(stagedConfigMutex);
+        stagedControlConfig = runtimeConfig;
+        controlConfigPending = true;
+    }
 #if TANKRC_ENABLE_NETWORK
+    if (!networkTaskHandle || caller == networkTaskHandle) {
+        applyNetworkConfig();
+    } else {
+        networkConfigPending = true;
+    }
+#endif
+}
+
+void applyControlConfig() {
+#if TANKRC_ENABLE_NETWORK
+    wifiHealthy = !(controlConfig.features.wifiEnabled && FEATURE_WIFI);
+#endif
+    Hal::applyConfig(controlConfig);
+    driveController.begin(controlConfig);
+
+#if FEATURE_SOUND
+    sound.begin(controlConfig.pins.speaker);
+    sound.setFeatureEnabled(controlConfig.features.soundEnabled);
+    sound.update(false);
+#endif
+    radio.begin(controlConfig);
+    updateHealthState();
+}
+
+#if TANKRC_ENABLE_NETWORK
+void applyNetworkConfig() {
+    std::lock_guard<std::recursive_mutex> lock(configMutex);
     const bool enableWifi = runtimeConfig.features.wifiEnabled && FEATURE_WIFI;
     if (enableWifi) {
         if (!wifiInitialized) {
@@ -345,22 +531,9 @@ void applyRuntimeConfig() {
         }
     }
     networkActive = enableWifi;
-    wifiHealthy = !networkActive;
-#endif
-    Hal::applyConfig(runtimeConfig);
-    driveController.begin(runtimeConfig);
-
-#if FEATURE_SOUND
-    sound.begin(runtimeConfig.pins.speaker);
-    sound.setFeatureEnabled(runtimeConfig.features.soundEnabled);
-    sound.update(false);
-#endif
-    radio.begin(runtimeConfig);
-#if TANKRC_ENABLE_NETWORK
     controlServer.notifyConfigApplied();
     ntpClock.configure(runtimeConfig);
     sessionLogger.configure(runtimeConfig.logging);
-#endif
     lastLogMs = 0;
-    updateHealthState();
 }
+#endif
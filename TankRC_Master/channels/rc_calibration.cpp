@@ -0,0 +1,96 @@
+#include "channels/rc_calibration.h"
+
+#include <algorithm>
+
+namespace TankRC::Channels {
+namespace {
+// A channel must sweep at least this far during capture before its endpoints are trusted.
+constexpr std::uint16_t kMinCaptureTravelUs = 200;
+constexpr std::uint16_t kCenterMarginUs = 50;
+}  // namespace
+
+RcCalibration::Segment RcCalibration::build(const Config::RcChannelCalibration& requested) {
+    // Web/console edits are not normalized until the next migration; never build a table
+    // from endpoints that are out of order.
+    const bool ordered = requested.minUs < requested.centerUs && requested.centerUs < requested.maxUs;
+    const Config::RcChannelCalibration cal = ordered ? requested : Config::RcChannelCalibration{};
+    Segment segment{};
+    segment.minUs = cal.minUs;
+    segment.maxUs = cal.maxUs;
+    segment.lowEdgeUs = std::max<std::int32_t>(segment.minUs + 1, cal.centerUs - cal.deadbandUs);
+    segment.highEdgeUs = std::max<std::int32_t>(segment.lowEdgeUs,
+                                                std::min<std::int32_t>(segment.maxUs - 1, cal.centerUs + cal.deadbandUs));
+    segment.lowSlope = (kQ15One << kSlopeShift) / (segment.lowEdgeUs - segment.minUs);
+    segment.highSlope = (kQ15One << kSlopeShift) / (segment.maxUs - segment.highEdgeUs);
+    segment.reversed = cal.reversed;
+    return segment;
+}
+
+void RcCalibration::configure(const Config::RcConfig& config) {
+    const Config::RcChannelCalibration defaults{};
+    for (std::size_t i = 0; i < kMaxChannels; ++i) {
+        segments_[i] = build(i < kCalibratedChannels ? config.calibration[i] : defaults);
+    }
+}
+
+std::int16_t RcCalibration::toQ15(std::size_t channel, unsigned long widthUs) const {
+    if (widthUs == 0 || channel >= kMaxChannels) {
+        return 0;
+    }
+    const Segment& segment = segments_[channel];
+    const std::int32_t width = std::clamp<std::int32_t>(static_cast<std::int32_t>(widthUs), segment.minUs, segment.maxUs);
+    std::int32_t value = 0;
+    if (width < segment.lowEdgeUs) {
+        value = -(((segment.lowEdgeUs - width) * segment.lowSlope) >> kSlopeShift);
+    } else if (width > segment.highEdgeUs) {
+        value = ((width - segment.highEdgeUs) * segment.highSlope) >> kSlopeShift;
+    }
+    value = std::clamp<std::int32_t>(value, -kQ15One, kQ15One);
+    return static_cast<std::int16_t>(segment.reversed ? -value : value);
+}
+
+void RcCalibrationCapture::start() {
+    active_ = true;
+    centerMarked_ = false;
+    minUs_.fill(0xFFFF);
+    maxUs_.fill(0);
+    lastUs_.fill(0);
+    centerUs_.fill(0);
+}
+
+void RcCalibrationCapture::cancel() {
+    active_ = false;
+    centerMarked_ = false;
+}
+
+void RcCalibrationCapture::markCenter() {
+    if (!active_) {
+        return;
+    }
+    centerUs_ = lastUs_;
+    centerMarked_ = true;
+}
+
+std::size_t RcCalibrationCapture::finish(Config::RcConfig& config) {
+    if (!active_) {
+        return 0;
+    }
+    std::size_t updated = 0;
+    for (std::size_t i = 0; i < kCalibratedChannels; ++i) {
+        if (maxUs_[i] == 0 || maxUs_[i] < minUs_[i] + kMinCaptureTravelUs) {
+            continue;
+        }
+        const std::uint16_t center = (centerMarked_ && centerUs_[i] != 0) ? centerUs_[i] : lastUs_[i];
+        // Switches and knobs are rarely centered when captured; fall back to the midpoint.
+        const bool centerUsable = center > minUs_[i] + kCenterMarginUs && center + kCenterMarginUs < maxUs_[i];
+        auto& cal = config.calibration[i];
+        cal.minUs = minUs_[i];
+        cal.maxUs = maxUs_[i];
+        cal.centerUs = centerUsable ? center : static_cast<std::uint16_t>((minUs_[i] + maxUs_[i]) / 2U);
+        ++updated;
+    }
+    active_ = false;
+    centerMarked_ = false;
+    return updated;
+}
+}  // namespace TankRC::Channels
@@ -0,0 +1,97 @@
+#pragma once
+#ifndef TANKRC_CHANNELS_RC_CALIBRATION_H
+#define TANKRC_CHANNELS_RC_CALIBRATION_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+
+#include "config/runtime_config.h"
+#include "drivers/rc_frame.h"
+
+namespace TankRC::Channels {
+constexpr std::size_t kCalibratedChannels = std::size(Config::RcConfig{}.calibration);
+
+// Per-channel piecewise-linear map from pulse width to Q15, rebuilt whenever the runtime
+// config changes. Slopes are precomputed so a frame costs one multiply and shift per channel.
+class RcCalibration {
+  public:
+    static constexpr std::int32_t kQ15One = 32767;
+    static constexpr float kQ15ToFloat = 1.0F / 32767.0F;
+
+    RcCalibration() { configure(Config::RcConfig{}); }
+
+    void configure(const Config::RcConfig& config);
+    std::int16_t toQ15(std::size_t channel, unsigned long widthUs) const;
+
+    // Fills frame.normalized from frame.widths; missing channels (width 0) read as 0.
+    template <std::size_t Channels>
+    void apply(Drivers::RcFrame<Channels>& frame) const {
+        for (std::size_t i = 0; i < Channels; ++i) {
+            frame.normalized[i] = static_cast<float>(toQ15(i, frame.widths[i])) * kQ15ToFloat;
+        }
+    }
+
+  private:
+    static constexpr std::size_t kMaxChannels = 16;
+    static constexpr int kSlopeShift = 12;
+
+    struct Segment {
+        std::int32_t minUs = 1000;
+        std::int32_t lowEdgeUs = 1500;   // center - deadband
+        std::int32_t highEdgeUs = 1500;  // center + deadband
+        std::int32_t maxUs = 2000;
+        std::int32_t lowSlope = 0;   // Q15 per µs, scaled by 2^kSlopeShift
+        std::int32_t highSlope = 0;
+        bool reversed = false;
+    };
+
+    static Segment build(const Config::RcChannelCalibration& cal);
+
+    std::array<Segment, kMaxChannels> segments_{};
+};
+
+// Records the travel of every calibrated channel while the operator sweeps the sticks.
+class RcCalibrationCapture {
+  public:
+    void start();
+    void cancel();
+    bool active() const { return active_; }
+    void markCenter();
+    // Writes endpoints/center for channels that moved far enough; deadband and reversal
+    // are left untouched. Returns the number of channels updated.
+    std::size_t finish(Config::RcConfig& config);
+
+    template <std::size_t Channels>
+    void observe(const Drivers::RcFrame<Channels>& frame) {
+        if (!active_) {
+            return;
+        }
+        for (std::size_t i = 0; i < Channels && i < kCalibratedChannels; ++i) {
+            const unsigned long width = frame.widths[i];
+            if (width == 0) {
+                continue;
+            }
+            const auto value = static_cast<std::uint16_t>(width);
+            lastUs_[i] = value;
+            minUs_[i] = std::min(minUs_[i], value);
+            maxUs_[i] = std::max(maxUs_[i], value);
+        }
+    }
+
+    std::uint16_t minUs(std::size_t channel) const { return channel < kCalibratedChannels ? minUs_[channel] : 0; }
+    std::uint16_t maxUs(std::size_t channel) const { return channel < kCalibratedChannels ? maxUs_[channel] : 0; }
+    std::uint16_t lastUs(std::size_t channel) const { return channel < kCalibratedChannels ? lastUs_[channel] : 0; }
+
+  private:
+    bool active_ = false;
+    bool centerMarked_ = false;
+    std::array<std::uint16_t, kCalibratedChannels> minUs_{};
+    std::array<std::uint16_t, kCalibratedChannels> maxUs_{};
+    std::array<std::uint16_t, kCalibratedChannels> lastUs_{};
+    std::array<std::uint16_t, kCalibratedChannels> centerUs_{};
+};
+}  // namespace TankRC::Channels
+#endif  // TANKRC_CHANNELS_RC_CALIBRATION_H
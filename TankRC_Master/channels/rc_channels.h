@@ -2,7 +2,7 @@
 
 #include <cstddef>
 
-#include "drivers/rc_receiver.h"
+#include "drivers/rc_frame.h"
 
 namespace TankRC::Channels {
 enum class RcChannel : std::size_t {
@@ -12,21 +12,43 @@ enum class RcChannel : std::size_t {
     Mode = 3,
     Aux5 = 4,
     Aux6 = 5,
+    // Only populated by serial receivers (SBUS/iBUS/CRSF); PWM frames stop at Aux6.
+    Aux7 = 6,
+    Aux8 = 7,
+    Aux9 = 8,
+    Aux10 = 9,
+    Aux11 = 10,
+    Aux12 = 11,
+    Aux13 = 12,
+    Aux14 = 13,
+    Aux15 = 14,
+    Aux16 = 15,
 };
 
-inline float readNormalized(const Drivers::RcReceiver::Frame& frame, RcChannel channel) {
+template <std::size_t Channels>
+inline float readNormalized(const Drivers::RcFrame<Channels>& frame, RcChannel channel) {
     const std::size_t idx = static_cast<std::size_t>(channel);
-    if (idx >= Drivers::RcReceiver::kChannelCount) {
+    if (idx >= Channels) {
         return 0.0F;
     }
     return frame.normalized[idx];
 }
 
-inline unsigned long readWidth(const Drivers::RcReceiver::Frame& frame, RcChannel channel) {
+template <std::size_t Channels>
+inline unsigned long readWidth(const Drivers::RcFrame<Channels>& frame, RcChannel channel) {
     const std::size_t idx = static_cast<std::size_t>(channel);
-    if (idx >= Drivers::RcReceiver::kChannelCount) {
+    if (idx >= Channels) {
         return 0UL;
     }
     return frame.widths[idx];
 }
+
+template <std::size_t Channels>
+inline unsigned long readAgeUs(const Drivers::RcFrame<Channels>& frame, RcChannel channel) {
+    const std::size_t idx = static_cast<std::size_t>(channel);
+    if (idx >= Channels) {
+        return 0UL;
+    }
+    return frame.ageUs[idx];
+}
 }  // namespace TankRC::Channels
@@ -0,0 +1,152 @@
+#pragma once
+#ifndef TANKRC_CHANNELS_RC_SIGNAL_QUALITY_H
+#define TANKRC_CHANNELS_RC_SIGNAL_QUALITY_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "config/runtime_config.h"
+#include "drivers/rc_frame.h"
+
+namespace TankRC::Channels {
+enum class FailsafeStage : std::uint8_t { Linked, Hold, Decelerate, Lock };
+
+inline const char* toString(FailsafeStage stage) {
+    switch (stage) {
+        case FailsafeStage::Linked:
+            return "linked";
+        case FailsafeStage::Hold:
+            return "hold";
+        case FailsafeStage::Decelerate:
+            return "decelerate";
+        default:
+            return "lock";
+    }
+}
+
+struct LinkState {
+    FailsafeStage stage = FailsafeStage::Lock;
+    std::uint8_t qualityPercent = 0;
+    std::uint32_t msSinceGood = 0;
+    float driveScale = 0.0F;  // 1 while linked/holding, ramps to 0 while decelerating
+};
+
+// Cleans raw receiver widths before calibration: median-of-3 per channel, stale samples
+// dropped, and the last good value held for a configurable window. The steering/throttle
+// pair drives a rolling link-quality figure and the staged failsafe.
+template <std::size_t Channels>
+class RcSignalQuality {
+  public:
+    void configure(const Config::RcFailsafeConfig& config) {
+        config_ = config;
+        decelerateScale_ = config_.decelerateMs > 0 ? 1.0F / static_cast<float>(config_.decelerateMs) : 0.0F;
+    }
+
+    LinkState update(Drivers::RcFrame<Channels>& frame, std::uint32_t nowMs) {
+        const unsigned long staleUs = static_cast<unsigned long>(config_.staleMs) * 1000UL;
+        bool primaryFresh = false;
+        for (std::size_t i = 0; i < Channels; ++i) {
+            auto& channel = channels_[i];
+            const unsigned long width = frame.widths[i];
+            const bool fresh = width > 0 && frame.ageUs[i] <= staleUs;
+            if (fresh) {
+                // PWM receivers are polled faster than they refresh; only feed new samples
+                // into the median window.
+                const unsigned long sampleUs = frame.captureUs - frame.ageUs[i];
+                if (channel.count == 0 || sampleUs != channel.lastSampleUs) {
+                    channel.lastSampleUs = sampleUs;
+                    channel.history[channel.next] = static_cast<std::uint16_t>(width);
+                    channel.next = static_cast<std::uint8_t>((channel.next + 1) % channel.history.size());
+                    channel.count = static_cast<std::uint8_t>(std::min<std::size_t>(channel.count + 1, channel.history.size()));
+                }
+                channel.lastGood = median(channel);
+                channel.lastGoodMs = nowMs;
+                frame.widths[i] = channel.lastGood;
+                if (i < kPrimaryChannels) {
+                    primaryFresh = true;
+                }
+                continue;
+            }
+            if (channel.count > 0 && (nowMs - channel.lastGoodMs) <= config_.holdMs) {
+                frame.widths[i] = channel.lastGood;
+            } else {
+                frame.widths[i] = 0;
+                channel.count = 0;
+                channel.next = 0;
+            }
+        }
+
+        qualityHistory_ = (qualityHistory_ << 1) | (primaryFresh ? 1ULL : 0ULL);
+        if (samples_ < kQualityWindow) {
+            ++samples_;
+        }
+        if (primaryFresh) {
+            lastPrimaryMs_ = nowMs;
+            everLinked_ = true;
+        }
+
+        LinkState state{};
+        state.qualityPercent = quality();
+        state.msSinceGood = everLinked_ ? nowMs - lastPrimaryMs_ : UINT32_MAX;
+        if (!everLinked_) {
+            state.stage = FailsafeStage::Lock;
+        } else if (state.msSinceGood == 0) {
+            state.stage = FailsafeStage::Linked;
+            state.driveScale = 1.0F;
+        } else if (state.msSinceGood <= config_.holdMs) {
+            state.stage = FailsafeStage::Hold;
+            state.driveScale = 1.0F;
+        } else if (state.msSinceGood <= static_cast<std::uint32_t>(config_.holdMs) + config_.decelerateMs) {
+            state.stage = FailsafeStage::Decelerate;
+            state.driveScale = 1.0F - static_cast<float>(state.msSinceGood - config_.holdMs) * decelerateScale_;
+        } else {
+            state.stage = FailsafeStage::Lock;
+        }
+        return state;
+    }
+
+  private:
+    static constexpr std::size_t kPrimaryChannels = 2;  // steering + throttle
+    static constexpr std::uint8_t kQualityWindow = 64;  // polls, ~320 ms at the 5 ms input task
+
+    struct ChannelState {
+        std::array<std::uint16_t, 3> history{};
+        std::uint8_t count = 0;
+        std::uint8_t next = 0;
+        std::uint16_t lastGood = 0;
+        std::uint32_t lastGoodMs = 0;
+        unsigned long lastSampleUs = 0;
+    };
+
+    static std::uint16_t median(const ChannelState& channel) {
+        if (channel.count < channel.history.size()) {
+            // Not enough samples yet to vote; trust the newest one.
+            return channel.history[(channel.next + channel.history.size() - 1) % channel.history.size()];
+        }
+        const std::uint16_t a = channel.history[0];
+        const std::uint16_t b = channel.history[1];
+        const std::uint16_t c = channel.history[2];
+        return std::max(std::min(a, b), std::min(std::max(a, b), c));
+    }
+
+    std::uint8_t quality() const {
+        if (samples_ == 0) {
+            return 0;
+        }
+        const std::uint64_t mask = samples_ >= 64 ? ~0ULL : ((1ULL << samples_) - 1ULL);
+        const int good = __builtin_popcountll(qualityHistory_ & mask);
+        return static_cast<std::uint8_t>((good * 100) / samples_);
+    }
+
+    Config::RcFailsafeConfig config_{};
+    float decelerateScale_ = 0.0F;
+    std::array<ChannelState, Channels> channels_{};
+    std::uint64_t qualityHistory_ = 0;
+    std::uint8_t samples_ = 0;
+    std::uint32_t lastPrimaryMs_ = 0;
+    bool everLinked_ = false;
+};
+}  // namespace TankRC::Channels
+#endif  // TANKRC_CHANNELS_RC_SIGNAL_QUALITY_H
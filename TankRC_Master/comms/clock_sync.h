@@ -0,0 +1,108 @@
+#pragma once
+#ifndef TANKRC_COMMS_CLOCK_SYNC_H
+#define TANKRC_COMMS_CLOCK_SYNC_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace TankRC::Comms {
+// NTP-style estimate of the slave's micros() relative to the master's, fed by ping/pong
+// timestamps: t1 master send, t2 slave receive, t3 slave send, t4 master receive. Each
+// group of kWindow exchanges contributes only its lowest-RTT sample, which has the least
+// queueing asymmetry. That sample steers a second-order loop that tracks both the
+// offset and the crystal drift between the boards. All arithmetic is modulo 2^32, so
+// micros() wrapping on either side is harmless.
+class ClockSync {
+  public:
+    static constexpr std::size_t kWindow = 8;
+    // A filtered sample this far off the prediction means the slave rebooted; start over.
+    static constexpr std::int32_t kResyncUs = 5000;
+
+    // Returns true when the estimate was updated.
+    bool addSample(std::uint32_t t1, std::uint32_t t2, std::uint32_t t3, std::uint32_t t4) {
+        auto rtt = static_cast<std::int32_t>((t4 - t1) - (t3 - t2));
+        rtt = std::max<std::int32_t>(rtt, 0);
+        const Sample sample{(t2 - t1) - static_cast<std::uint32_t>(rtt / 2),
+                            t1 + (t4 - t1) / 2,
+                            static_cast<std::uint32_t>(rtt)};
+        if (pending_ == 0 || sample.rttUs < best_.rttUs) {
+            best_ = sample;
+        }
+        if (++pending_ < kWindow) {
+            return false;
+        }
+        pending_ = 0;
+        apply(best_);
+        return true;
+    }
+
+    void reset() {
+        synced_ = false;
+        pending_ = 0;
+    }
+
+    bool synced() const { return synced_; }
+    // Slave clock minus master clock at the last update, in µs (modulo 2^32).
+    std::int32_t offsetUs() const { return static_cast<std::int32_t>(offset_); }
+    float driftPpm() const { return drift_ * 1e6F; }
+    // Last filtered sample minus the prediction.
+    std::int32_t residualUs() const { return residual_; }
+    std::uint32_t bestRttUs() const { return best_.rttUs; }
+    std::uint32_t updates() const { return updates_; }
+    std::uint32_t resyncs() const { return resyncs_; }
+
+    // Converts a slave micros() reading to the master's micros().
+    std::uint32_t toMasterUs(std::uint32_t slaveUs) const {
+        const auto elapsed = static_cast<std::int32_t>((slaveUs - offset_) - refUs_);
+        return slaveUs - offset_ - static_cast<std::uint32_t>(std::lround(drift_ * static_cast<float>(elapsed)));
+    }
+
+  private:
+    static constexpr float kOffsetGain = 0.25F;
+    static constexpr float kDriftGain = 0.02F;
+    static constexpr float kMaxDrift = 500e-6F;  // well past any crystal tolerance
+
+    struct Sample {
+        std::uint32_t offsetUs = 0;
+        std::uint32_t atUs = 0;  // master time of the exchange midpoint
+        std::uint32_t rttUs = 0;
+    };
+
+    void apply(const Sample& sample) {
+        ++updates_;
+        if (synced_) {
+            const auto elapsed = static_cast<float>(static_cast<std::int32_t>(sample.atUs - refUs_));
+            const float predicted = drift_ * elapsed;
+            const float residual = static_cast<float>(static_cast<std::int32_t>(sample.offsetUs - offset_)) - predicted;
+            residual_ = static_cast<std::int32_t>(std::lround(residual));
+            if (std::abs(residual_) <= kResyncUs) {
+                offset_ += static_cast<std::uint32_t>(static_cast<std::int32_t>(std::lround(predicted + kOffsetGain * residual)));
+                if (elapsed > 0.0F) {
+                    drift_ = std::clamp(drift_ + kDriftGain * residual / elapsed, -kMaxDrift, kMaxDrift);
+                }
+                refUs_ = sample.atUs;
+                return;
+            }
+            ++resyncs_;
+        }
+        offset_ = sample.offsetUs;
+        refUs_ = sample.atUs;
+        drift_ = 0.0F;
+        residual_ = 0;
+        synced_ = true;
+    }
+
+    bool synced_ = false;
+    std::size_t pending_ = 0;
+    Sample best_{};
+    std::uint32_t offset_ = 0;
+    std::uint32_t refUs_ = 0;
+    float drift_ = 0.0F;  // d(offset)/d(master time)
+    std::int32_t residual_ = 0;
+    std::uint32_t updates_ = 0;
+    std::uint32_t resyncs_ = 0;
+};
+}  // namespace TankRC::Comms
+#endif  // TANKRC_COMMS_CLOCK_SYNC_H
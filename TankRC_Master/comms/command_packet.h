@@ -0,0 +1,36 @@
+#pragma once
+#ifndef TANKRC_COMMS_COMMAND_PACKET_H
+#define TANKRC_COMMS_COMMAND_PACKET_H
+
+#include <cstdint>
+
+#include "channels/rc_signal_quality.h"
+
+namespace TankRC::Comms {
+struct DriveCommand {
+    float throttle = 0.0F;
+    float turn = 0.0F;
+    // Latency trace (micros): receiver edge behind this command and the poll that read it.
+    // Zero when the command is not backed by a fresh sample (hold, failsafe, console).
+    std::uint32_t inputUs = 0;
+    std::uint32_t pollUs = 0;
+};
+
+enum class RcStatusMode { Debug, Active, Locked };
+
+struct CommandPacket {
+    DriveCommand drive{};
+    bool lightingState = false;
+    bool soundState = false;
+    bool auxButton = false;
+    bool hazard = false;
+    RcStatusMode status = RcStatusMode::Active;
+    float auxChannel5 = 0.0F;
+    float auxChannel6 = 0.0F;
+    bool rcLinked = true;
+    bool wifiConnected = true;
+    std::uint8_t linkQuality = 0;
+    Channels::FailsafeStage failsafe = Channels::FailsafeStage::Linked;
+};
+}  // namespace TankRC::Comms
+#endif  // TANKRC_COMMS_COMMAND_PACKET_H
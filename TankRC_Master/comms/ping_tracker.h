@@ -0,0 +1,103 @@
+#pragma once
+#ifndef TANKRC_COMMS_PING_TRACKER_H
+#define TANKRC_COMMS_PING_TRACKER_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "diagnostics/link_stats.h"
+
+namespace TankRC::Comms {
+// Matches pongs to outstanding pings and keeps the round-trip statistics. A ping counts as
+// lost once it has gone unanswered for kTimeoutUs or its slot is needed for a newer ping;
+// a pong that turns up after that is ignored.
+class PingTracker {
+  public:
+    static constexpr std::uint32_t kTimeoutUs = 250000;
+
+    // Registers a ping sent at `nowUs` and returns its id.
+    std::uint8_t send(std::uint32_t nowUs) {
+        const std::uint8_t id = nextId_++;
+        Slot& slot = slots_[id % slots_.size()];
+        if (slot.pending) {
+            resolve(false);
+        }
+        slot = {nowUs, id, true};
+        ++quality_.sent;
+        return id;
+    }
+
+    // `rttUs` is the caller's round trip with the peer's turnaround already removed.
+    bool receive(std::uint8_t id, std::uint32_t rttUs) {
+        Slot& slot = slots_[id % slots_.size()];
+        if (!slot.pending || slot.id != id) {
+            return false;
+        }
+        slot.pending = false;
+        resolve(true);
+        if (quality_.answered > 1) {
+            const std::uint32_t delta = rttUs > quality_.rttUs ? rttUs - quality_.rttUs : quality_.rttUs - rttUs;
+            jitter_ += (static_cast<float>(delta) - jitter_) / 16.0F;
+            quality_.jitterUs = static_cast<std::uint32_t>(jitter_);
+        }
+        quality_.rttUs = rttUs;
+        if (quality_.answered == 1 || rttUs < quality_.minRttUs) {
+            quality_.minRttUs = rttUs;
+        }
+        if (rttUs > quality_.maxRttUs) {
+            quality_.maxRttUs = rttUs;
+        }
+        std::size_t bucket = 0;
+        while (bucket < kRttBoundsSize && rttUs > Diagnostics::kRttBoundsUs[bucket]) {
+            ++bucket;
+        }
+        ++quality_.histogram[bucket];
+        return true;
+    }
+
+    void expire(std::uint32_t nowUs) {
+        for (auto& slot : slots_) {
+            if (slot.pending && (nowUs - slot.sentUs) > kTimeoutUs) {
+                slot.pending = false;
+                resolve(false);
+            }
+        }
+    }
+
+    const Diagnostics::LinkQuality& quality() const { return quality_; }
+
+  private:
+    static constexpr std::size_t kRttBoundsSize = Diagnostics::kRttBoundsUs.size();
+    static constexpr std::uint8_t kLossWindow = 64;
+
+    struct Slot {
+        std::uint32_t sentUs = 0;
+        std::uint8_t id = 0;
+        bool pending = false;
+    };
+
+    void resolve(bool answered) {
+        history_ = (history_ << 1) | (answered ? 1ULL : 0ULL);
+        if (samples_ < kLossWindow) {
+            ++samples_;
+        }
+        if (answered) {
+            ++quality_.answered;
+        } else {
+            ++quality_.lost;
+        }
+        const std::uint64_t mask = samples_ >= 64 ? ~0ULL : ((1ULL << samples_) - 1ULL);
+        const int good = __builtin_popcountll(history_ & mask);
+        quality_.lossPercent = static_cast<std::uint8_t>(((samples_ - good) * 100) / samples_);
+    }
+
+    std::array<Slot, 8> slots_{};
+    std::uint8_t nextId_ = 0;
+    std::uint64_t history_ = 0;
+    std::uint8_t samples_ = 0;
+    float jitter_ = 0.0F;
+    Diagnostics::LinkQuality quality_{};
+};
+}  // namespace TankRC::Comms
+#endif  // TANKRC_COMMS_PING_TRACKER_H
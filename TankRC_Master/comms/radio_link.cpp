@@ -1,56 +1,102 @@
 #include <Arduino.h>
 #include <algorithm>
+#include <iterator>
 
 #include "comms/radio_link.h"
 #include "channels/rc_channels.h"
+#include "diagnostics/journal.h"
+#include "diagnostics/latency_trace.h"
 #include "hal/hal.h"
 
 namespace TankRC::Comms {
 namespace {
-float clampRange(float value) {
-    return std::max(-1.0F, std::min(1.0F, value));
+constexpr std::uint32_t kCalibrationWaitStepMs = 5;
+}  // namespace
+
+void RadioLink::begin(const Config::RuntimeConfig& config) {
+    rc_ = config.rc;
+    pipeline_.configure(rc_);
+    Diagnostics::Journal::recordRcConfig(rc_, Hal::millis32());
 }
 
-RcStatusMode modeFromChannel(float value) {
-    if (value > 0.33F) {
-        return RcStatusMode::Debug;
-    }
-    if (value < -0.33F) {
-        return RcStatusMode::Locked;
-    }
-    return RcStatusMode::Active;
+void RadioLink::requestCalibration(CalibrationStep step) {
+    calibrationRequest_.store(step, std::memory_order_release);
 }
 
-float toZeroOne(float value) {
-    return (clampRange(value) + 1.0F) * 0.5F;
+bool RadioLink::finishCalibration(Config::RuntimeConfig& config, std::size_t& updated, std::uint32_t timeoutMs) {
+    const std::uint32_t before = calibrationResult_.read().sequence;
+    requestCalibration(CalibrationStep::Finish);
+    for (std::uint32_t waitedMs = 0; waitedMs <= timeoutMs; waitedMs += kCalibrationWaitStepMs) {
+        const CalibrationResult result = calibrationResult_.read();
+        if (result.sequence != before) {
+            // Only the captured endpoints; deadband and reversal may have been edited since.
+            for (std::size_t i = 0; i < std::size(config.rc.calibration); ++i) {
+                config.rc.calibration[i].minUs = result.rc.calibration[i].minUs;
+                config.rc.calibration[i].centerUs = result.rc.calibration[i].centerUs;
+                config.rc.calibration[i].maxUs = result.rc.calibration[i].maxUs;
+            }
+            updated = result.updated;
+            return true;
+        }
+        delay(kCalibrationWaitStepMs);
+    }
+    return false;
 }
-}  // namespace
 
-void RadioLink::begin(const Config::RuntimeConfig& config) {
+void RadioLink::serviceCalibration() {
+    const CalibrationStep step = calibrationRequest_.exchange(CalibrationStep::None, std::memory_order_acquire);
+    switch (step) {
+        case CalibrationStep::Start:
+            capture_.start();
+            break;
+        case CalibrationStep::Center:
+            capture_.markCenter();
+            break;
+        case CalibrationStep::Cancel:
+            capture_.cancel();
+            break;
+        case CalibrationStep::Finish: {
+            if (!capture_.active()) {
+                break;
+            }
+            CalibrationResult result{};
+            result.rc = rc_;
+            result.updated = static_cast<std::uint32_t>(capture_.finish(result.rc));
+            rc_ = result.rc;
+            pipeline_.configure(rc_);
+            result.sequence = ++calibrationSequence_;
+            calibrationResult_.write(result);
+            break;
+        }
+        default:
+            break;
+    }
+    calibrating_.store(capture_.active(), std::memory_order_relaxed);
 }
 
 CommandPacket RadioLink::poll() {
-    CommandPacket packet{};
-    const auto frame = Hal::readRcFrame();
-
-    packet.drive.turn = clampRange(Channels::readNormalized(frame, Channels::RcChannel::Steering));
-    packet.drive.throttle = clampRange(Channels::readNormalized(frame, Channels::RcChannel::Throttle));
-    const float auxPrimary = Channels::readNormalized(frame, Channels::RcChannel::AuxPrimary);
-    packet.auxButton = auxPrimary > 0.35F;
-    packet.hazard = auxPrimary < -0.35F;
-    packet.status = modeFromChannel(Channels::readNormalized(frame, Channels::RcChannel::Mode));
-    const unsigned long aux5Width = Channels::readWidth(frame, Channels::RcChannel::Aux5);
-    const unsigned long aux6Width = Channels::readWidth(frame, Channels::RcChannel::Aux6);
-    packet.auxChannel5 = aux5Width > 0 ? toZeroOne(Channels::readNormalized(frame, Channels::RcChannel::Aux5)) : 1.0F;
-    packet.auxChannel6 = aux6Width > 0 ? toZeroOne(Channels::readNormalized(frame, Channels::RcChannel::Aux6)) : 1.0F;
-    packet.rcLinked = (Channels::readWidth(frame, Channels::RcChannel::Steering) > 0 ||
-                       Channels::readWidth(frame, Channels::RcChannel::Throttle) > 0);
-    packet.wifiConnected = true;
-
-    // Simple defaults: aux button toggles lighting, sound follows mode.
-    packet.lightingState = packet.auxButton;
-    packet.soundState = packet.status == RcStatusMode::Active;
+    serviceCalibration();
+    auto frame = Hal::readRcFrame();
+    const std::uint32_t nowMs = Hal::millis32();
+    Diagnostics::Journal::recordFrame(frame, nowMs);
+    const Channels::LinkState link = pipeline_.filter(frame, nowMs);
+    capture_.observe(frame);
+    CommandPacket packet = pipeline_.map(frame, link);
+    Diagnostics::Journal::recordDrive(packet, nowMs);
 
+    if (link.stage == Channels::FailsafeStage::Linked) {
+        // Trace the newer of the two drive samples. PWM receivers are polled several times
+        // per pulse, so each edge is only recorded on the poll that first sees it.
+        const unsigned long ageUs = std::min(Channels::readAgeUs(frame, Channels::RcChannel::Steering),
+                                             Channels::readAgeUs(frame, Channels::RcChannel::Throttle));
+        const auto inputUs = static_cast<std::uint32_t>(frame.captureUs - ageUs);
+        if (inputUs != lastTracedInputUs_) {
+            lastTracedInputUs_ = inputUs;
+            Diagnostics::recordLatency(Diagnostics::LatencyStage::Input, static_cast<std::uint32_t>(ageUs));
+        }
+        packet.drive.inputUs = inputUs;
+        packet.drive.pollUs = static_cast<std::uint32_t>(frame.captureUs);
+    }
     return packet;
 }
 }  // namespace TankRC::Comms
@@ -2,35 +2,51 @@
 #ifndef TANKRC_COMMS_RADIO_LINK_H
 #define TANKRC_COMMS_RADIO_LINK_H
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "channels/rc_calibration.h"
+#include "comms/command_packet.h"
+#include "comms/rc_pipeline.h"
 #include "config/runtime_config.h"
+#include "core/snapshot.h"
+#include "drivers/rc_input.h"
 
 namespace TankRC::Comms {
-struct DriveCommand {
-    float throttle = 0.0F;
-    float turn = 0.0F;
-};
-
-enum class RcStatusMode { Debug, Active, Locked };
-
-struct CommandPacket {
-    DriveCommand drive{};
-    bool lightingState = false;
-    bool soundState = false;
-    bool auxButton = false;
-    bool hazard = false;
-    RcStatusMode status = RcStatusMode::Active;
-    float auxChannel5 = 0.0F;
-    float auxChannel6 = 0.0F;
-    bool rcLinked = true;
-    bool wifiConnected = true;
-};
-
 class RadioLink {
   public:
     void begin(const Config::RuntimeConfig& config);
     CommandPacket poll();
 
+    // Calibration capture: start, sweep every stick/switch, center the sticks, then finish.
+    // Any task may request a step; poll() runs it on the control task, so the capture and
+    // the calibration tables are never touched from another core.
+    enum class CalibrationStep : std::uint8_t { None, Start, Center, Cancel, Finish };
+    void requestCalibration(CalibrationStep step);
+    // Requests Finish and waits up to `timeoutMs` for poll() to apply it. On success the
+    // captured endpoints are copied into `config` and `updated` holds the channel count.
+    // Must not be called from the task that runs poll().
+    bool finishCalibration(Config::RuntimeConfig& config, std::size_t& updated, std::uint32_t timeoutMs);
+    bool calibrating() const { return calibrating_.load(std::memory_order_relaxed); }
+
   private:
+    struct CalibrationResult {
+        std::uint32_t sequence = 0;
+        std::uint32_t updated = 0;
+        Config::RcConfig rc{};
+    };
+
+    void serviceCalibration();
+
+    RcPipeline<Drivers::RcInput::kChannelCount> pipeline_{};
+    Config::RcConfig rc_{};  // as last configured; Finish captures into a copy of it
+    Channels::RcCalibrationCapture capture_{};
+    std::atomic<CalibrationStep> calibrationRequest_{CalibrationStep::None};
+    std::atomic<bool> calibrating_{false};
+    Core::Snapshot<CalibrationResult> calibrationResult_{};
+    std::uint32_t calibrationSequence_ = 0;
+    std::uint32_t lastTracedInputUs_ = 0;
 };
 }  // namespace TankRC::Comms
 #endif  // TANKRC_COMMS_RADIO_LINK_H
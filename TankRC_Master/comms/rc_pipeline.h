@@ -0,0 +1,99 @@
+#pragma once
+#ifndef TANKRC_COMMS_RC_PIPELINE_H
+#define TANKRC_COMMS_RC_PIPELINE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+#include "channels/rc_calibration.h"
+#include "channels/rc_channels.h"
+#include "channels/rc_signal_quality.h"
+#include "comms/command_packet.h"
+#include "config/runtime_config.h"
+#include "drivers/rc_frame.h"
+
+namespace TankRC::Comms {
+// Receiver frame -> CommandPacket: signal-quality filter, calibration and the staged
+// failsafe. It reads no hardware and no clock, so tools/journal_replay runs this exact
+// code over a recorded journal.
+template <std::size_t ChannelCount>
+class RcPipeline {
+  public:
+    using Frame = Drivers::RcFrame<ChannelCount>;
+
+    void configure(const Config::RcConfig& config) {
+        calibration_.configure(config);
+        quality_.configure(config.failsafe);
+    }
+
+    // Step 1: median/stale filtering and link state. Leaves cleaned widths in `frame`.
+    Channels::LinkState filter(Frame& frame, std::uint32_t nowMs) {
+        return quality_.update(frame, nowMs);
+    }
+
+    // Step 2: calibrate the filtered frame and map it onto a packet.
+    CommandPacket map(Frame& frame, const Channels::LinkState& link) {
+        calibration_.apply(frame);
+
+        CommandPacket packet{};
+        packet.drive.turn = clampRange(Channels::readNormalized(frame, Channels::RcChannel::Steering));
+        packet.drive.throttle = clampRange(Channels::readNormalized(frame, Channels::RcChannel::Throttle));
+        const float auxPrimary = Channels::readNormalized(frame, Channels::RcChannel::AuxPrimary);
+        packet.auxButton = auxPrimary > 0.35F;
+        packet.hazard = auxPrimary < -0.35F;
+        packet.status = modeFromChannel(Channels::readNormalized(frame, Channels::RcChannel::Mode));
+        const unsigned long aux5Width = Channels::readWidth(frame, Channels::RcChannel::Aux5);
+        const unsigned long aux6Width = Channels::readWidth(frame, Channels::RcChannel::Aux6);
+        packet.auxChannel5 = aux5Width > 0 ? toZeroOne(Channels::readNormalized(frame, Channels::RcChannel::Aux5)) : 1.0F;
+        packet.auxChannel6 = aux6Width > 0 ? toZeroOne(Channels::readNormalized(frame, Channels::RcChannel::Aux6)) : 1.0F;
+        packet.linkQuality = link.qualityPercent;
+        packet.failsafe = link.stage;
+        // Holding keeps the last filtered values flowing, so the link only reads as lost once
+        // the hold window has expired.
+        packet.rcLinked = link.stage == Channels::FailsafeStage::Linked || link.stage == Channels::FailsafeStage::Hold;
+        if (packet.rcLinked) {
+            lastDrive_ = packet.drive;
+            lastStatus_ = packet.status;
+        } else if (link.stage == Channels::FailsafeStage::Decelerate) {
+            packet.drive.throttle = lastDrive_.throttle * link.driveScale;
+            packet.drive.turn = lastDrive_.turn * link.driveScale;
+            packet.status = lastStatus_;
+        } else {
+            packet.drive = {};
+            packet.status = RcStatusMode::Locked;
+        }
+        packet.wifiConnected = true;
+
+        // Simple defaults: aux button toggles lighting, sound follows mode.
+        packet.lightingState = packet.auxButton;
+        packet.soundState = packet.status == RcStatusMode::Active;
+        return packet;
+    }
+
+  private:
+    static float clampRange(float value) {
+        return std::max(-1.0F, std::min(1.0F, value));
+    }
+
+    static RcStatusMode modeFromChannel(float value) {
+        if (value > 0.33F) {
+            return RcStatusMode::Debug;
+        }
+        if (value < -0.33F) {
+            return RcStatusMode::Locked;
+        }
+        return RcStatusMode::Active;
+    }
+
+    static float toZeroOne(float value) {
+        return (clampRange(value) + 1.0F) * 0.5F;
+    }
+
+    Channels::RcCalibration calibration_{};
+    Channels::RcSignalQuality<ChannelCount> quality_{};
+    DriveCommand lastDrive_{};
+    RcStatusMode lastStatus_ = RcStatusMode::Locked;
+};
+}  // namespace TankRC::Comms
+#endif  // TANKRC_COMMS_RC_PIPELINE_H
@@ -1,53 +1,355 @@
 #include "comms/slave_link.h"
 
 #include <Arduino.h>
+#include <algorithm>
+#include <cmath>
 #include <cstring>
 
+#include "../profiler/profiler.h"
+#include "diagnostics/latency_trace.h"
+#include "diagnostics/link_stats.h"
+
 namespace TankRC::Comms {
 namespace {
-constexpr unsigned long kCommandIntervalMs = 20;
+// Lighting rides in every full command frame; compact streams send it separately, at
+// this rate or immediately when its status/flags change.
+constexpr unsigned long kLightingIntervalMs = 100;
 constexpr unsigned long kStatusTimeoutMs = 500;
+constexpr unsigned long kBaud = 921600;
+// UART driver ring buffer: ~11 ms of line time at kBaud, so a stalled loop drops nothing.
+constexpr std::size_t kRxBufferSize = 1024;
+constexpr unsigned long kConfigRetryMinMs = 50;
+constexpr unsigned long kConfigRetryMaxMs = 1000;
+constexpr unsigned long kTrafficWindowMs = 1000;
+constexpr unsigned long kPingIntervalMs = 50;
+constexpr unsigned long kHelloRetryMs = 200;
+// A slave that keeps sending status but ignores this many Hellos predates protocol 2.
+constexpr std::uint8_t kHelloUnansweredLimit = 10;
+// Advertised in every Hello; compact commands stay off when the build disables them.
+constexpr std::uint8_t kEncodings = TANKRC_SLAVE_COMPACT_COMMANDS ? SlaveProtocol::EncodingCompactCommand : 0;
+constexpr std::uint16_t kFeatures = SlaveProtocol::FeatureTelemetry | SlaveProtocol::FeaturePing |
+                                    SlaveProtocol::FeatureLatencyEcho | SlaveProtocol::FeaturePerf;
+// The link reads degraded past any of these while status frames still arrive.
+constexpr std::uint8_t kDegradedLossPercent = 10;
+constexpr std::uint32_t kDegradedRttUs = 5000;
+constexpr std::uint32_t kDegradedJitterUs = 2000;
+constexpr unsigned long kDegradedSilenceMs = 4 * kPingIntervalMs;
+// Framed command sizes (compact frames have no length byte), 10 bits per byte on the wire.
+constexpr std::uint32_t kCommandFrameBytes =
+    SlaveProtocol::frameBytes(SlaveProtocol::FrameType::Command, sizeof(SlaveProtocol::CommandPayload));
+constexpr std::uint32_t kCompactCommandFrameBytes =
+    SlaveProtocol::frameBytes(SlaveProtocol::FrameType::CompactCommand, sizeof(SlaveProtocol::CompactCommandPayload));
+constexpr std::uint32_t kCommandWireUs = static_cast<std::uint32_t>((kCommandFrameBytes * 10UL * 1000000UL) / kBaud);
+static_assert(sizeof(Config::SlaveLinkConfig::telemetryPeriodMs) == sizeof(SlaveProtocol::TelemetrySubscribePayload),
+              "one telemetry period per group");
+constexpr std::uint32_t kCompactCommandWireUs =
+    static_cast<std::uint32_t>((kCompactCommandFrameBytes * 10UL * 1000000UL) / kBaud);
 }  // namespace
 
 void SlaveLink::begin(const Config::RuntimeConfig& config) {
-    rxPin_ = config.pins.slaveRx;
-    txPin_ = config.pins.slaveTx;
+    commandIntervalUs_ = 1000000UL / std::max<std::uint16_t>(config.slaveLink.commandRateHz, 1);
+    heartbeatUs_ = static_cast<unsigned long>(config.slaveLink.heartbeatMs) * 1000UL;
+    throttleEpsilon_ = static_cast<float>(config.slaveLink.throttleEpsilonPermille) * 0.001F;
+    turnEpsilon_ = static_cast<float>(config.slaveLink.turnEpsilonPermille) * 0.001F;
+    // Runs on every config apply; the UART is only reopened when its pins change.
+    if (!serialOpen_ || rxPin_ != config.pins.slaveRx || txPin_ != config.pins.slaveTx) {
+        rxPin_ = config.pins.slaveRx;
+        txPin_ = config.pins.slaveTx;
+        openSerial();
+    }
+    codec_.attach(serial_);
+    startHello();
+    applyConfig(config);
+}
+
+void SlaveLink::openSerial() {
+    if (serialOpen_) {
+        serial_->end();  // the driver refuses to resize its ring buffer while running
+    }
+    serial_->setRxBufferSize(kRxBufferSize);
     if (rxPin_ >= 0 && txPin_ >= 0) {
-        serial_->begin(921600, SERIAL_8N1, rxPin_, txPin_);
+        serial_->begin(kBaud, SERIAL_8N1, rxPin_, txPin_);
     } else {
-        serial_->begin(921600);
+        serial_->begin(kBaud);
     }
-    resetParser();
-    applyConfig(config);
+    serialOpen_ = true;
 }
 
 void SlaveLink::applyConfig(const Config::RuntimeConfig& config) {
-    SlaveProtocol::ConfigPayload payload{};
-    payload.pins = config.pins;
-    payload.features = config.features;
-    payload.lighting = config.lighting;
-    sendFrame(SlaveProtocol::FrameType::Config,
-              reinterpret_cast<const std::uint8_t*>(&payload),
-              sizeof(payload));
+    config_ = {};
+    config_.pins = config.pins;
+    config_.features = config.features;
+    config_.lighting = config.lighting;
+    configSync_.hash = SlaveProtocol::configHash(config_);
+    configSync_.pending = true;
+    configRetryMs_ = kConfigRetryMinMs;
+    sendConfig();
+
+    subscribedGroups_ = 0;
+    for (std::size_t i = 0; i < SlaveProtocol::kTelemetryGroupCount; ++i) {
+        subscription_.periodMs[i] = config.slaveLink.telemetryPeriodMs[i];
+        if (subscription_.periodMs[i] > 0) {
+            subscribedGroups_ |= SlaveProtocol::telemetryBit(static_cast<SlaveProtocol::TelemetryGroup>(i));
+        }
+    }
+    sendTelemetrySubscribe();
+}
+
+void SlaveLink::sendConfig() {
+    codec_.send(SlaveProtocol::FrameType::Config, config_);
+    configSentMs_ = millis();
+    ++configSync_.sends;
+    Diagnostics::storeConfigSync(configSync_);
+}
+
+void SlaveLink::startHello() {
+    protocol_.pending = true;
+    protocol_.replied = false;
+    protocol_.compatible = false;
+    protocol_.result = SlaveProtocol::HelloResult::Ok;
+    protocol_.encodings = 0;
+    helloUnanswered_ = 0;
+    updateCommandLayout();
+    sendHello();
+}
+
+void SlaveLink::sendHello() {
+    const SlaveProtocol::HelloPayload hello = SlaveProtocol::makeHello(kEncodings, kFeatures);
+    codec_.send(SlaveProtocol::FrameType::Hello, hello);
+    helloSentMs_ = millis();
+    protocol_.version = hello.version;
+    protocol_.configBytes = hello.configBytes;
+    ++protocol_.hellos;
+    Diagnostics::storeLinkProtocol(protocol_);
+}
+
+void SlaveLink::serviceHello(unsigned long now) {
+    if (!protocol_.pending || (now - helloSentMs_) < kHelloRetryMs) {
+        return;
+    }
+    if (online() && helloUnanswered_ < kHelloUnansweredLimit && ++helloUnanswered_ == kHelloUnansweredLimit) {
+        protocol_.result = SlaveProtocol::HelloResult::PeerTooOld;
+        ++protocol_.mismatches;
+    }
+    sendHello();
+}
+
+void SlaveLink::handleHelloReply(const SlaveProtocol::HelloReplyPayload& reply) {
+    // Either side refusing is enough; ours is checked first so the reason names the slave.
+    const auto local = SlaveProtocol::checkHello(SlaveProtocol::makeHello(kEncodings, kFeatures), reply.slave);
+    const auto remote = static_cast<SlaveProtocol::HelloResult>(reply.result);
+    protocol_.result = local != SlaveProtocol::HelloResult::Ok ? local : remote;
+    protocol_.compatible = protocol_.result == SlaveProtocol::HelloResult::Ok;
+    protocol_.encodings = protocol_.compatible ? static_cast<std::uint8_t>(kEncodings & reply.encodings) : 0;
+    protocol_.slaveVersion = reply.slave.version;
+    protocol_.slaveMinVersion = reply.slave.minVersion;
+    protocol_.slaveFeatures = reply.slave.features;
+    protocol_.slaveConfigBytes = reply.slave.configBytes;
+    protocol_.pending = false;
+    protocol_.replied = true;
+    if (!protocol_.compatible) {
+        ++protocol_.mismatches;
+    }
+    Diagnostics::storeLinkProtocol(protocol_);
+    updateCommandLayout();
+}
+
+void SlaveLink::updateCommandLayout() {
+    const bool compact = protocol_.compatible && (protocol_.encodings & SlaveProtocol::EncodingCompactCommand) != 0;
+    if (compact && !compact_) {
+        lightingDirty_ = true;  // the slave's lighting state came from full frames until now
+    }
+    compact_ = compact;
+}
+
+void SlaveLink::serviceConfig(unsigned long now) {
+    if (!configSync_.pending || (now - configSentMs_) < configRetryMs_) {
+        return;
+    }
+    ++configSync_.retries;
+    configRetryMs_ = std::min(configRetryMs_ * 2, kConfigRetryMaxMs);
+    sendConfig();
+}
+
+void SlaveLink::handleConfigAck(const SlaveProtocol::ConfigAckPayload& ack) {
+    if (!ack.accepted) {
+        // Leave the retry timer running; a mismatched slave firmware keeps nacking at the
+        // capped rate rather than flooding the link.
+        ++configSync_.nacks;
+    } else if (ack.hash == configSync_.hash) {
+        configSync_.pending = false;
+        configSync_.slaveHash = ack.hash;
+    }
+    Diagnostics::storeConfigSync(configSync_);
+}
+
+void SlaveLink::checkSlaveConfig() {
+    configSync_.slaveHash = lastStatus_.configHash;
+    if (!configSync_.pending && lastStatus_.configHash != configSync_.hash) {
+        // The slave reset or dropped our config; push it again.
+        ++configSync_.resyncs;
+        configSync_.pending = true;
+        configRetryMs_ = kConfigRetryMinMs;
+        sendConfig();
+    }
+    Diagnostics::storeConfigSync(configSync_);
+}
+
+void SlaveLink::sendTelemetrySubscribe() {
+    codec_.send(SlaveProtocol::FrameType::TelemetrySubscribe, subscription_);
+}
+
+void SlaveLink::checkTelemetrySubscription() {
+    // Repeats at the status rate until the slave reports the groups we asked for.
+    if (lastStatus_.telemetryGroups != subscribedGroups_) {
+        sendTelemetrySubscribe();
+    }
+}
+
+void SlaveLink::handleTelemetry(const std::uint8_t* payload, std::uint8_t length) {
+    SlaveProtocol::TelemetryHeader header{};
+    if (length < sizeof(header)) {
+        return;
+    }
+    std::memcpy(&header, payload, sizeof(header));
+    const std::uint8_t groups = header.groups;
+    std::size_t offset = sizeof(header);
+    const std::uint32_t sampledMs = masterMs(header.stampUs);
+    for (std::size_t i = 0; i < SlaveProtocol::kTelemetryGroupCount; ++i) {
+        const auto group = static_cast<SlaveProtocol::TelemetryGroup>(i);
+        if ((groups & SlaveProtocol::telemetryBit(group)) == 0) {
+            continue;
+        }
+        void* target = nullptr;
+        switch (group) {
+            case SlaveProtocol::TelemetryGroup::Motors:
+                target = &telemetry_.motors;
+                break;
+            case SlaveProtocol::TelemetryGroup::Pid:
+                target = &telemetry_.pid;
+                break;
+            case SlaveProtocol::TelemetryGroup::Loop:
+                target = &telemetry_.loop;
+                break;
+            case SlaveProtocol::TelemetryGroup::I2c:
+                target = &telemetry_.i2c;
+                break;
+            case SlaveProtocol::TelemetryGroup::System:
+                target = &telemetry_.system;
+                break;
+            default:
+                break;
+        }
+        const std::size_t size = SlaveProtocol::telemetryGroupSize(group);
+        if (!target || offset + size > length) {
+            // Layout disagrees with this firmware; keep the groups decoded so far.
+            break;
+        }
+        std::memcpy(target, &payload[offset], size);
+        telemetry_.sampledMs[i] = sampledMs;
+        offset += size;
+    }
+    ++telemetry_.frames;
+    telemetry_.clockSynced = clock_.synced();
+    Diagnostics::storeSlaveTelemetry(telemetry_);
+}
+
+void SlaveLink::servicePing(unsigned long now) {
+    if ((now - lastPingMs_) < kPingIntervalMs) {
+        return;
+    }
+    lastPingMs_ = now;
+    const auto nowUs = static_cast<std::uint32_t>(micros());
+    ping_.expire(nowUs);
+    SlaveProtocol::PingPayload ping{};
+    ping.masterUs = nowUs;
+    ping.id = ping_.send(nowUs);
+    codec_.send(SlaveProtocol::FrameType::Ping, ping);
+
+    Diagnostics::LinkQuality quality = ping_.quality();
+    quality.online = online();
+    quality.degraded = quality.online &&
+                       (quality.lossPercent >= kDegradedLossPercent || quality.rttUs > kDegradedRttUs ||
+                        quality.jitterUs > kDegradedJitterUs || (now - lastPongMs_) > kDegradedSilenceMs);
+    Diagnostics::storeLinkQuality(quality);
+}
+
+void SlaveLink::handlePong(const SlaveProtocol::PongPayload& pong) {
+    const auto nowUs = static_cast<std::uint32_t>(micros());
+    const std::uint32_t turnaroundUs = pong.slaveTxUs - pong.slaveRxUs;
+    const std::uint32_t elapsedUs = nowUs - pong.masterUs;
+    if (ping_.receive(pong.id, elapsedUs > turnaroundUs ? elapsedUs - turnaroundUs : 0)) {
+        lastPongMs_ = millis();
+    }
+    if (clock_.addSample(pong.masterUs, pong.slaveRxUs, pong.slaveTxUs, nowUs)) {
+        Diagnostics::SlaveClock clock{};
+        clock.synced = clock_.synced();
+        clock.offsetUs = clock_.offsetUs();
+        clock.driftPpm = clock_.driftPpm();
+        clock.residualUs = clock_.residualUs();
+        clock.bestRttUs = clock_.bestRttUs();
+        clock.updates = clock_.updates();
+        clock.resyncs = clock_.resyncs();
+        Diagnostics::storeSlaveClock(clock);
+    }
+}
+
+std::uint32_t SlaveLink::masterMs(std::uint32_t slaveUs) const {
+    const auto nowMs = static_cast<std::uint32_t>(millis());
+    if (!clock_.synced()) {
+        return nowMs;  // best effort until the first offset estimate: time of arrival
+    }
+    const auto agoUs = static_cast<std::int32_t>(static_cast<std::uint32_t>(micros()) - clock_.toMasterUs(slaveUs));
+    return nowMs - static_cast<std::uint32_t>(agoUs / 1000);
 }
 
 void SlaveLink::setCommand(const DriveCommand& command) {
     command_ = command;
-    commandDirty_ = true;
+    ++commandSamples_;
+    const bool changed = std::fabs(command.throttle - sentCommand_.throttle) > throttleEpsilon_ ||
+                         std::fabs(command.turn - sentCommand_.turn) > turnEpsilon_;
+    // One more sample after the sticks stop lets the slave drop the slope it was following.
+    if (changed || moving_) {
+        commandStampUs_ = static_cast<std::uint16_t>(micros());
+        commandDirty_ = true;
+    } else {
+        ++traffic_.commandsSuppressed;
+    }
+    moving_ = changed;
 }
 
 void SlaveLink::setLightingCommand(const SlaveProtocol::LightingCommand& lighting) {
+    if (lighting.status != lighting_.status || lighting.flags != lighting_.flags) {
+        lightingDirty_ = true;
+        commandDirty_ = commandDirty_ || !compact_;
+    }
+    // Ultrasonic levels only ride along with the next frame that goes out anyway.
     lighting_ = lighting;
-    commandDirty_ = true;
 }
 
 void SlaveLink::update() {
     processIncoming();
     const unsigned long now = millis();
-    if (commandDirty_ || (now - lastSendMs_) >= kCommandIntervalMs) {
+    const bool up = online();
+    if (wasOnline_ && !up) {
+        startHello();  // whatever answers next may be different firmware
+    }
+    wasOnline_ = up;
+    serviceHello(now);
+    serviceConfig(now);
+    servicePing(now);
+    const unsigned long nowUs = micros();
+    const unsigned long repeatUs = moving_ ? commandIntervalUs_ : heartbeatUs_;
+    if (commandDirty_ || (nowUs - lastSendUs_) >= repeatUs) {
         sendCommand();
         commandDirty_ = false;
-        lastSendMs_ = now;
+        lastSendUs_ = nowUs;
+    }
+    updateTraffic(now);
+    if (compact_ && (lightingDirty_ || (now - lastLightingMs_) >= kLightingIntervalMs)) {
+        codec_.send(SlaveProtocol::FrameType::Lighting, lighting_);
+        lightingDirty_ = false;
+        lastLightingMs_ = now;
     }
 }
 
@@ -55,85 +357,122 @@ bool SlaveLink::online() const {
     return (lastStatusMs_ != 0) && (millis() - lastStatusMs_ < kStatusTimeoutMs);
 }
 
+void SlaveLink::updateTraffic(unsigned long now) {
+    if ((now - trafficWindowMs_) < kTrafficWindowMs) {
+        return;
+    }
+    const std::uint32_t frameBytes = compact_ ? kCompactCommandFrameBytes : kCommandFrameBytes;
+    const std::uint32_t baselineBytes = commandSamples_ * frameBytes;
+    traffic_.txBytesPerSec = codec_.txBytes() - windowTxStart_;
+    traffic_.commandBytesPerSec = windowCommandBytes_;
+    traffic_.savedBytesPerSec = baselineBytes > windowCommandBytes_ ? baselineBytes - windowCommandBytes_ : 0;
+    Diagnostics::storeLinkTraffic(traffic_);
+    windowTxStart_ = codec_.txBytes();
+    windowCommandBytes_ = 0;
+    commandSamples_ = 0;
+    trafficWindowMs_ = now;
+}
+
 void SlaveLink::sendCommand() {
+    sentCommand_ = command_;
+    ++traffic_.commandsSent;
+    if (compact_) {
+        SlaveProtocol::CompactCommandPayload payload{};
+        payload.throttle = SlaveProtocol::toQ15(command_.throttle);
+        payload.turn = SlaveProtocol::toQ15(command_.turn);
+        payload.stampUs = commandStampUs_;
+        const std::uint8_t seq = codec_.send(SlaveProtocol::FrameType::CompactCommand, payload);
+        traceSend(seq, kCompactCommandWireUs);
+        windowCommandBytes_ += kCompactCommandFrameBytes;
+        return;
+    }
     SlaveProtocol::CommandPayload payload{};
     payload.throttle = command_.throttle;
     payload.turn = command_.turn;
     payload.lighting = lighting_;
-    sendFrame(SlaveProtocol::FrameType::Command,
-              reinterpret_cast<const std::uint8_t*>(&payload),
-              sizeof(payload));
+    payload.stampUs = commandStampUs_;
+    const std::uint8_t seq = codec_.send(SlaveProtocol::FrameType::Command, payload);
+    traceSend(seq, kCommandWireUs);
+    windowCommandBytes_ += kCommandFrameBytes;
+    lightingDirty_ = false;
 }
 
-void SlaveLink::sendFrame(SlaveProtocol::FrameType type, const std::uint8_t* payload, std::uint8_t length) {
-    if (!serial_) {
+void SlaveLink::traceSend(std::uint8_t seq, std::uint32_t wireUs) {
+    // Commands are resent every cycle; only the first send of each input sample counts.
+    if (command_.inputUs == 0 || command_.inputUs == lastSentInputUs_) {
         return;
     }
-    serial_->write(SlaveProtocol::kMagic);
-    serial_->write(static_cast<std::uint8_t>(type));
-    serial_->write(length);
-    if (payload && length > 0) {
-        serial_->write(payload, length);
+    lastSentInputUs_ = command_.inputUs;
+    const auto sendUs = static_cast<std::uint32_t>(micros());
+    Diagnostics::recordLatency(Diagnostics::LatencyStage::Dispatch, sendUs - command_.pollUs);
+    Diagnostics::recordLatency(Diagnostics::LatencyStage::Wire, wireUs);
+    sentTraces_[nextTrace_] = {command_.inputUs, sendUs, wireUs, seq};
+    nextTrace_ = static_cast<std::uint8_t>((nextTrace_ + 1) % sentTraces_.size());
+}
+
+void SlaveLink::traceStatus() {
+    Diagnostics::noteLatencyMax(Diagnostics::LatencyStage::SlaveApply, lastStatus_.applyMaxUs);
+    if ((lastStatus_.flags & SlaveProtocol::StatusEchoValid) == 0) {
+        return;
+    }
+    for (auto& trace : sentTraces_) {
+        if (trace.inputUs == 0 || trace.seq != lastStatus_.echoSeq) {
+            continue;
+        }
+        // Each stage runs on its own clock, so the total is the sum of the stage times.
+        Diagnostics::recordLatency(Diagnostics::LatencyStage::SlaveApply, lastStatus_.applyUs);
+        Diagnostics::recordLatency(Diagnostics::LatencyStage::Total,
+                                   (trace.sendUs - trace.inputUs) + trace.wireUs + lastStatus_.applyUs);
+        trace.inputUs = 0;  // the slave echoes until a newer command lands; count it once
+        break;
     }
-    const std::uint8_t sum = SlaveProtocol::checksum(type, length, payload);
-    serial_->write(sum);
 }
 
 void SlaveLink::processIncoming() {
-    if (!serial_) {
-        return;
+    static const Profiler::SectionId profile = Profiler::registerSection("uart rx");
+    Profiler::Scope scope(profile);
+
+    using Routes = SlaveProtocol::FrameTable<
+        SlaveProtocol::On<SlaveProtocol::FrameType::Status, SlaveProtocol::StatusPayload, &SlaveLink::handleStatus>,
+        SlaveProtocol::On<SlaveProtocol::FrameType::Pong, SlaveProtocol::PongPayload, &SlaveLink::handlePong>,
+        SlaveProtocol::OnBytes<SlaveProtocol::FrameType::Telemetry, &SlaveLink::handleTelemetry>,
+        SlaveProtocol::On<SlaveProtocol::FrameType::ConfigAck, SlaveProtocol::ConfigAckPayload, &SlaveLink::handleConfigAck>,
+        SlaveProtocol::On<SlaveProtocol::FrameType::Perf, SlaveProtocol::PerfPayload, &SlaveLink::storeSlavePerf>,
+        SlaveProtocol::On<SlaveProtocol::FrameType::HelloReply, SlaveProtocol::HelloReplyPayload,
+                          &SlaveLink::handleHelloReply>>;
+    if (!online()) {
+        // The slave has been silent; its sequence may have restarted or wrapped.
+        codec_.resetSequence();
     }
+    codec_.receive<Routes>(*this);
+    Diagnostics::storeLinkCounters(Diagnostics::LinkDirection::FromSlave, codec_.rxCounters());
+    if (codec_.lengthErrors() != protocol_.lengthErrors) {
+        protocol_.lengthErrors = codec_.lengthErrors();
+        Diagnostics::storeLinkProtocol(protocol_);
+    }
+}
 
-    while (serial_->available()) {
-        std::uint8_t byte = static_cast<std::uint8_t>(serial_->read());
-        switch (parseState_) {
-            case ParseState::Magic:
-                if (byte == SlaveProtocol::kMagic) {
-                    parseState_ = ParseState::Type;
-                }
-                break;
-            case ParseState::Type:
-                currentType_ = byte;
-                parseState_ = ParseState::Length;
-                break;
-            case ParseState::Length:
-                expectedLength_ = byte;
-                payloadPos_ = 0;
-                checksum_ = static_cast<std::uint8_t>(currentType_) ^ expectedLength_;
-                if (expectedLength_ > payload_.size()) {
-                    resetParser();
-                } else if (expectedLength_ == 0) {
-                    parseState_ = ParseState::Checksum;
-                } else {
-                    parseState_ = ParseState::Payload;
-                }
-                break;
-            case ParseState::Payload:
-                payload_[payloadPos_++] = byte;
-                checksum_ ^= byte;
-                if (payloadPos_ >= expectedLength_) {
-                    parseState_ = ParseState::Checksum;
-                }
-                break;
-            case ParseState::Checksum:
-                if (checksum_ == byte) {
-                    if (currentType_ == static_cast<std::uint8_t>(SlaveProtocol::FrameType::Status) &&
-                        expectedLength_ == sizeof(SlaveProtocol::StatusPayload)) {
-                        std::memcpy(&lastStatus_, payload_.data(), sizeof(SlaveProtocol::StatusPayload));
-                        lastStatusMs_ = millis();
-                    }
-                }
-                resetParser();
-                break;
-        }
+void SlaveLink::handleStatus(const SlaveProtocol::StatusPayload& status) {
+    lastStatus_ = status;
+    lastStatusMs_ = millis();
+    traceStatus();
+    if ((status.flags & SlaveProtocol::StatusHelloSeen) == 0 && !protocol_.pending) {
+        startHello();  // the slave rebooted and lost the negotiated encodings
     }
+    Diagnostics::storeLinkCounters(Diagnostics::LinkDirection::ToSlave, lastStatus_.rx);
+    checkSlaveConfig();
+    checkTelemetrySubscription();
 }
 
-void SlaveLink::resetParser() {
-    parseState_ = ParseState::Magic;
-    currentType_ = 0;
-    expectedLength_ = 0;
-    payloadPos_ = 0;
-    checksum_ = 0;
+void SlaveLink::storeSlavePerf(const SlaveProtocol::PerfPayload& perf) {
+    Profiler::Summary summary{};
+    std::memcpy(summary.name, perf.name, sizeof(summary.name));
+    summary.count = perf.count;
+    summary.minUs = perf.minUs;
+    summary.avgUs = perf.avgUs;
+    summary.maxUs = perf.maxUs;
+    summary.p99Us = perf.p99Us;
+    summary.loadPermille = perf.loadPermille;
+    Profiler::storeRemote(perf.index, summary);
 }
 }  // namespace TankRC::Comms
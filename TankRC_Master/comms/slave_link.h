@@ -7,9 +7,14 @@
 
 #include <HardwareSerial.h>
 
+#include "comms/clock_sync.h"
+#include "comms/ping_tracker.h"
 #include "comms/radio_link.h"
-#include "comms/slave_protocol.h"
+#include "config/build_config.h"
 #include "config/runtime_config.h"
+#include "diagnostics/link_stats.h"
+#include "diagnostics/slave_telemetry.h"
+#include "../link/frame_codec.h"
 
 namespace TankRC::Comms {
 class SlaveLink {
@@ -18,35 +23,107 @@ class SlaveLink {
     void applyConfig(const Config::RuntimeConfig& config);
     void setCommand(const DriveCommand& command);
     void setLightingCommand(const SlaveProtocol::LightingCommand& lighting);
+    // Services the UART and the command stream; call at least as often as the configured
+    // command rate (the master runs it from a 1 ms task).
     void update();
 
     float batteryVoltage() const { return lastStatus_.batteryVoltage; }
     bool online() const;
+    // Maps a slave micros() reading onto the master's millis() time base.
+    std::uint32_t masterMs(std::uint32_t slaveUs) const;
 
   private:
-    void sendFrame(SlaveProtocol::FrameType type, const std::uint8_t* payload, std::uint8_t length);
+    void openSerial();
     void sendCommand();
+    void sendConfig();
+    void serviceConfig(unsigned long now);
+    void handleConfigAck(const SlaveProtocol::ConfigAckPayload& ack);
+    void checkSlaveConfig();
+    void sendTelemetrySubscribe();
+    void checkTelemetrySubscription();
+    void handleTelemetry(const std::uint8_t* payload, std::uint8_t length);
+    void servicePing(unsigned long now);
+    void handlePong(const SlaveProtocol::PongPayload& pong);
+    void startHello();
+    void sendHello();
+    void serviceHello(unsigned long now);
+    void handleHelloReply(const SlaveProtocol::HelloReplyPayload& reply);
+    void updateCommandLayout();
+    void updateTraffic(unsigned long now);
     void processIncoming();
-    void resetParser();
-
-    enum class ParseState { Magic, Type, Length, Payload, Checksum };
+    void traceSend(std::uint8_t seq, std::uint32_t wireUs);
+    void traceStatus();
+    void handleStatus(const SlaveProtocol::StatusPayload& status);
+    void storeSlavePerf(const SlaveProtocol::PerfPayload& perf);
 
     HardwareSerial* serial_ = &Serial1;
     int rxPin_ = 16;
     int txPin_ = 17;
+    bool serialOpen_ = false;
     DriveCommand command_{};
     SlaveProtocol::LightingCommand lighting_{};
     bool commandDirty_ = false;
-    unsigned long lastSendMs_ = 0;
+    std::uint16_t commandStampUs_ = 0;
+    unsigned long commandIntervalUs_ = 5000;
+    unsigned long lastSendUs_ = 0;
+    // Change suppression: commands within epsilon of the last one sent stay queued until
+    // the heartbeat; `moving_` is set while consecutive samples keep changing.
+    DriveCommand sentCommand_{};
+    bool moving_ = false;
+    float throttleEpsilon_ = 0.0F;
+    float turnEpsilon_ = 0.0F;
+    unsigned long heartbeatUs_ = 100000;
+    Diagnostics::LinkTraffic traffic_{};
+    std::uint32_t commandSamples_ = 0;
+    std::uint32_t windowTxStart_ = 0;
+    std::uint32_t windowCommandBytes_ = 0;
+    unsigned long trafficWindowMs_ = 0;
+    // CompactCommand + Lighting frames once both Hellos list the encoding.
+    bool compact_ = false;
+    bool lightingDirty_ = false;
+    unsigned long lastLightingMs_ = 0;
     unsigned long lastStatusMs_ = 0;
     SlaveProtocol::StatusPayload lastStatus_{};
+    bool wasOnline_ = false;
+
+    // Hello is sent at bring-up and again whenever the link drops or the slave's status
+    // shows it has not answered one since it booted. Until a compatible reply arrives only
+    // the baseline frames are used.
+    Diagnostics::LinkProtocol protocol_{};
+    unsigned long helloSentMs_ = 0;
+    std::uint8_t helloUnanswered_ = 0;  // retries while the slave's status keeps arriving
+
+    // Config stays pending until the slave acks its hash; unacked sends back off
+    // exponentially so a slave that is still booting is not flooded.
+    SlaveProtocol::ConfigPayload config_{};
+    unsigned long configSentMs_ = 0;
+    unsigned long configRetryMs_ = 0;
+    Diagnostics::ConfigSync configSync_{};
+
+    // Telemetry groups requested from the slave. The slave forgets them on reset; its status
+    // lists the groups it is sending, and a mismatch triggers a resubscribe.
+    SlaveProtocol::TelemetrySubscribePayload subscription_{};
+    std::uint8_t subscribedGroups_ = 0;
+    Diagnostics::SlaveTelemetry telemetry_{};
+
+    PingTracker ping_{};
+    // Fed by the same pongs; places slave timestamps on the master clock.
+    ClockSync clock_{};
+    unsigned long lastPingMs_ = 0;
+    unsigned long lastPongMs_ = 0;
+
+    SlaveProtocol::FrameCodec<HardwareSerial> codec_{&Serial1};
 
-    ParseState parseState_ = ParseState::Magic;
-    std::uint8_t currentType_ = 0;
-    std::uint8_t expectedLength_ = 0;
-    std::uint8_t payloadPos_ = 0;
-    std::uint8_t checksum_ = 0;
-    std::array<std::uint8_t, SlaveProtocol::kMaxPayload> payload_{};
+    // Recently sent traced commands, matched against the seq the slave echoes back.
+    struct SentTrace {
+        std::uint32_t inputUs = 0;
+        std::uint32_t sendUs = 0;
+        std::uint32_t wireUs = 0;
+        std::uint8_t seq = 0;
+    };
+    std::array<SentTrace, 8> sentTraces_{};
+    std::uint8_t nextTrace_ = 0;
+    std::uint32_t lastSentInputUs_ = 0;
 };
 }  // namespace TankRC::Comms
 #endif  // TANKRC_COMMS_SLAVE_LINK_H
@@ -9,3 +9,20 @@
 #ifndef TANKRC_USE_DRIVE_PROXY
 #define TANKRC_USE_DRIVE_PROXY 1
 #endif
+
+// Stream Q15 CompactCommand frames to slaves that advertise support; 0 keeps the
+// float Command layout.
+#ifndef TANKRC_SLAVE_COMPACT_COMMANDS
+#define TANKRC_SLAVE_COMPACT_COMMANDS 1
+#endif
+
+// RC receiver backend: six PWM pins (default) or a single-wire serial receiver on
+// Serial2, with its RX pin taken from the first RC channel pin.
+#define TANKRC_RC_PROTOCOL_PWM 0
+#define TANKRC_RC_PROTOCOL_SBUS 1
+#define TANKRC_RC_PROTOCOL_IBUS 2
+#define TANKRC_RC_PROTOCOL_CRSF 3
+
+#ifndef TANKRC_RC_PROTOCOL
+#define TANKRC_RC_PROTOCOL TANKRC_RC_PROTOCOL_PWM
+#endif
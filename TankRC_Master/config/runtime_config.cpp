@@ -76,6 +76,9 @@ constexpr int kMinPcaChannel = -1;
 constexpr int kMaxPcaChannel = 15;
 constexpr int kMinPcfAddress = 0x20;
 constexpr int kMaxPcfAddress = 0x27;
+constexpr std::uint16_t kMinRcPulseUs = 800;
+constexpr std::uint16_t kMaxRcPulseUs = 2200;
+constexpr std::uint16_t kMaxRcDeadbandUs = 200;
 
 int clampGpio(int pin) {
     if (pin < kMinGpio || pin > kMaxGpio) {
@@ -146,6 +149,22 @@ bool normalizeLightingChannels(LightingChannelMap& map, const LightingChannelMap
     return changed;
 }
 
+bool normalizeRcCalibration(RcChannelCalibration& cal, const RcChannelCalibration& defaults) {
+    const bool ordered = cal.minUs >= kMinRcPulseUs && cal.minUs < cal.centerUs && cal.centerUs < cal.maxUs &&
+                         cal.maxUs <= kMaxRcPulseUs;
+    if (!ordered) {
+        cal = defaults;
+        return true;
+    }
+    const std::uint16_t halfSpan = std::min<std::uint16_t>(cal.centerUs - cal.minUs, cal.maxUs - cal.centerUs);
+    const std::uint16_t maxDeadband = std::min<std::uint16_t>(kMaxRcDeadbandUs, halfSpan - 1);
+    if (cal.deadbandUs > maxDeadband) {
+        cal.deadbandUs = maxDeadband;
+        return true;
+    }
+    return false;
+}
+
 template <typename T>
 bool clampRange(T& value, T minValue, T maxValue) {
     const T clamped = std::clamp(value, minValue, maxValue);
@@ -196,6 +215,22 @@ bool migrateConfig(RuntimeConfig& config, std::uint32_t fromVersion) {
     for (std::size_t i = 0; i < std::size(config.rc.channelPins); ++i) {
         changed |= normalizeGpio(config.rc.channelPins[i], defaults.rc.channelPins[i]);
     }
+    for (std::size_t i = 0; i < std::size(config.rc.calibration); ++i) {
+        changed |= normalizeRcCalibration(config.rc.calibration[i], defaults.rc.calibration[i]);
+    }
+    changed |= clampRange<std::uint16_t>(config.rc.failsafe.holdMs, 0, 2000);
+    changed |= clampRange<std::uint16_t>(config.rc.failsafe.decelerateMs, 0, 5000);
+    changed |= clampRange<std::uint16_t>(config.rc.failsafe.staleMs, 10, 500);
+    changed |= clampRange<std::uint8_t>(config.rc.failsafe.degradedQuality, 0, 100);
+    changed |= clampRange<std::uint16_t>(config.slaveLink.commandRateHz, 50, 1000);
+    changed |= clampRange<std::uint16_t>(config.slaveLink.heartbeatMs, 20, 250);
+    changed |= clampRange<std::uint16_t>(config.slaveLink.throttleEpsilonPermille, 0, 100);
+    changed |= clampRange<std::uint16_t>(config.slaveLink.turnEpsilonPermille, 0, 100);
+    for (auto& periodMs : config.slaveLink.telemetryPeriodMs) {
+        if (periodMs != 0) {
+            changed |= clampRange<std::uint16_t>(periodMs, 20, 60000);
+        }
+    }
 
     changed |= normalizeLightingChannels(config.lighting.channels, defaults.lighting.channels);
     changed |= clampRange<std::uint16_t>(config.lighting.pwmFrequency, 100, 1600);
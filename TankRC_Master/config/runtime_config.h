@@ -7,7 +7,7 @@
 #include "config/features.h"
 
 namespace TankRC::Config {
-constexpr std::uint32_t kConfigVersion = 10;
+constexpr std::uint32_t kConfigVersion = 15;
 
 struct ChannelPins {
     int pwm = -1;
@@ -86,8 +86,38 @@ struct LoggingConfig {
     std::uint16_t maxEntries = 512;
 };
 
+struct RcChannelCalibration {
+    std::uint16_t minUs = 1000;
+    std::uint16_t centerUs = 1500;
+    std::uint16_t maxUs = 2000;
+    std::uint16_t deadbandUs = 0;
+    bool reversed = false;
+};
+
+// Staged RC failsafe: hold the last good values, then ramp drive to zero, then lock.
+struct RcFailsafeConfig {
+    std::uint16_t holdMs = 250;
+    std::uint16_t decelerateMs = 750;
+    std::uint16_t staleMs = 60;           // samples older than this are ignored
+    std::uint8_t degradedQuality = 70;    // link quality % below which Health reports degraded
+};
+
 struct RcConfig {
     int channelPins[6]{-1, -1, -1, -1, -1, -1};
+    RcChannelCalibration calibration[6]{};
+    RcFailsafeConfig failsafe{};
+};
+
+// Master -> slave drive command stream. A command that moved by more than its epsilon is
+// sent straight away and repeated at commandRateHz while the sticks keep moving, so a lost
+// frame is covered quickly. A still command only goes out as a heartbeat.
+struct SlaveLinkConfig {
+    std::uint16_t commandRateHz = 200;
+    std::uint16_t heartbeatMs = 100;
+    std::uint16_t throttleEpsilonPermille = 2;
+    std::uint16_t turnEpsilonPermille = 2;
+    // Slave telemetry period per group (motors, pid, loop, i2c, system); 0 = not sent.
+    std::uint16_t telemetryPeriodMs[5]{100, 100, 500, 1000, 1000};
 };
 
 struct RuntimeConfig {
@@ -99,6 +129,7 @@ struct RuntimeConfig {
     NtpConfig ntp{};
     LoggingConfig logging{};
     RcConfig rc{};
+    SlaveLinkConfig slaveLink{};
 };
 
 RuntimeConfig makeDefaultConfig();
@@ -1,7 +1,7 @@
 #pragma once
 
 #include "comms/radio_link.h"
-#include "comms/slave_protocol.h"
+#include "../link/slave_protocol.h"
 #include "config/runtime_config.h"
 
 #ifndef TANKRC_USE_DRIVE_PROXY
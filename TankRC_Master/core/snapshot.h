@@ -0,0 +1,46 @@
+#pragma once
+#ifndef TANKRC_CORE_SNAPSHOT_H
+#define TANKRC_CORE_SNAPSHOT_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace TankRC::Core {
+// Single-writer sequence lock for handing small structs between the control and network
+// tasks. The writer never blocks; a reader that overlaps a write retries the copy. Only one
+// task may call write(), and it must not be starved by a reader spinning on the same core.
+template <typename T>
+class Snapshot {
+    static_assert(std::is_trivially_copyable<T>::value, "Snapshot payloads are copied bytewise");
+
+  public:
+    void write(const T& value) {
+        const std::uint32_t sequence = sequence_.load(std::memory_order_relaxed);
+        sequence_.store(sequence + 1U, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(&value_, &value, sizeof(T));
+        sequence_.store(sequence + 2U, std::memory_order_release);
+    }
+
+    T read() const {
+        T copy{};
+        while (true) {
+            const std::uint32_t before = sequence_.load(std::memory_order_acquire);
+            if ((before & 1U) == 0U) {
+                std::memcpy(&copy, &value_, sizeof(T));
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (sequence_.load(std::memory_order_relaxed) == before) {
+                    return copy;
+                }
+            }
+        }
+    }
+
+  private:
+    std::atomic<std::uint32_t> sequence_{0};
+    T value_{};
+};
+}  // namespace TankRC::Core
+#endif  // TANKRC_CORE_SNAPSHOT_H
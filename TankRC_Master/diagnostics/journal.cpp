@@ -0,0 +1,158 @@
+#include "diagnostics/journal.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+
+namespace TankRC::Diagnostics::Journal {
+namespace {
+std::array<std::uint8_t, kCapacityBytes> ring{};
+std::size_t head = 0;  // next write offset
+std::size_t tail = 0;  // start of the oldest record
+std::size_t used = 0;
+std::uint32_t recordCount = 0;
+std::uint32_t evictedCount = 0;
+std::uint32_t skippedCount = 0;
+
+// RC config in effect at the oldest record still in the ring; refreshed as config records
+// are evicted so a replay always starts from the right calibration.
+using ConfigRecord = std::array<std::uint8_t, kRecordHeaderBytes + kMaxPayloadBytes>;
+ConfigRecord baseConfig{};
+std::size_t baseConfigBytes = 0;
+ConfigRecord latestConfig{};
+std::size_t latestConfigBytes = 0;
+
+// Export handshake: the reader raises `exporting` and waits for `writing` to clear; the
+// writer skips appends while an export is copying. Both sides use seq_cst so neither can
+// miss the other's flag. exportTo() and clear() each claim `exporting` with a
+// compare-exchange, so only one of them can own the ring at a time.
+std::atomic<bool> exporting{false};
+std::atomic<bool> writing{false};
+
+void copyOut(std::size_t offset, std::uint8_t* out, std::size_t length) {
+    for (std::size_t i = 0; i < length; ++i) {
+        out[i] = ring[(offset + i) % kCapacityBytes];
+    }
+}
+
+void copyIn(const std::uint8_t* data, std::size_t length) {
+    for (std::size_t i = 0; i < length; ++i) {
+        ring[head] = data[i];
+        head = (head + 1) % kCapacityBytes;
+    }
+}
+
+void evictOldest() {
+    std::uint8_t header[kRecordHeaderBytes];
+    copyOut(tail, header, sizeof(header));
+    const std::size_t recordBytes = kRecordHeaderBytes + header[1];
+    if (header[0] == static_cast<std::uint8_t>(RecordType::RcConfig)) {
+        copyOut(tail, baseConfig.data(), recordBytes);
+        baseConfigBytes = recordBytes;
+    }
+    tail = (tail + recordBytes) % kCapacityBytes;
+    used -= recordBytes;
+    --recordCount;
+    ++evictedCount;
+}
+
+// Takes the ring for exportTo() or clear(); false when the other one already holds it.
+bool claimRing() {
+    bool expected = false;
+    if (!exporting.compare_exchange_strong(expected, true)) {
+        return false;
+    }
+    while (writing) {
+    }
+    return true;
+}
+}  // namespace
+
+void append(RecordType type, std::uint32_t timeMs, const std::uint8_t* payload, std::size_t length) {
+    if (length > kMaxPayloadBytes) {
+        return;
+    }
+    writing = true;
+    if (exporting) {
+        writing = false;
+        ++skippedCount;
+        return;
+    }
+    const std::size_t recordBytes = kRecordHeaderBytes + length;
+    while (kCapacityBytes - used < recordBytes) {
+        evictOldest();
+    }
+    std::uint8_t header[kRecordHeaderBytes];
+    ByteWriter w(header);
+    w.u8(static_cast<std::uint8_t>(type));
+    w.u8(static_cast<std::uint8_t>(length));
+    w.u32(timeMs);
+    copyIn(header, sizeof(header));
+    copyIn(payload, length);
+    if (type == RecordType::RcConfig) {
+        std::copy(header, header + sizeof(header), latestConfig.begin());
+        std::copy(payload, payload + length, latestConfig.begin() + sizeof(header));
+        latestConfigBytes = recordBytes;
+    }
+    used += recordBytes;
+    ++recordCount;
+    writing = false;
+}
+
+void recordRcConfig(const Config::RcConfig& config, std::uint32_t nowMs) {
+    std::uint8_t payload[kMaxPayloadBytes];
+    append(RecordType::RcConfig, nowMs, payload, encodeRcConfig(config, payload));
+}
+
+void recordDrive(const Comms::CommandPacket& packet, std::uint32_t nowMs) {
+    std::uint8_t payload[kMaxPayloadBytes];
+    append(RecordType::Drive, nowMs, payload, encodeDrive(toDriveRecord(packet), payload));
+}
+
+void recordEvent(const Events::Event& event) {
+    std::uint8_t payload[kMaxPayloadBytes];
+    append(RecordType::Event, event.timestampMs, payload, encodeEvent(event, payload));
+}
+
+bool exportTo(std::vector<std::uint8_t>& out, std::uint8_t rcChannels) {
+    if (!claimRing()) {
+        return false;
+    }
+    out.clear();
+    out.reserve(kFileHeaderBytes + baseConfigBytes + used);
+    out.insert(out.end(), std::begin(kMagic), std::end(kMagic));
+    out.push_back(kVersion);
+    out.push_back(rcChannels);
+    out.push_back(0);
+    out.push_back(0);
+    out.insert(out.end(), baseConfig.begin(), baseConfig.begin() + baseConfigBytes);
+    const std::size_t start = out.size();
+    out.resize(start + used);
+    copyOut(tail, out.data() + start, used);
+    exporting = false;
+    return true;
+}
+
+bool clear() {
+    if (!claimRing()) {
+        return false;
+    }
+    head = tail = used = 0;
+    baseConfig = latestConfig;
+    baseConfigBytes = latestConfigBytes;
+    recordCount = 0;
+    evictedCount = 0;
+    skippedCount = 0;
+    exporting = false;
+    return true;
+}
+
+Stats stats() {
+    Stats out{};
+    out.records = recordCount;
+    out.evicted = evictedCount;
+    out.skipped = skippedCount;
+    out.bytes = used;
+    return out;
+}
+}  // namespace TankRC::Diagnostics::Journal
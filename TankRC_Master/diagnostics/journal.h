@@ -0,0 +1,49 @@
+#pragma once
+#ifndef TANKRC_DIAGNOSTICS_JOURNAL_H
+#define TANKRC_DIAGNOSTICS_JOURNAL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "diagnostics/journal_format.h"
+
+// Incident journal: a RAM ring of raw RC frames, the drive packets made from them and every
+// dispatched event, in the format of journal_format.h. Oldest records are evicted first.
+// Only the control task writes; export() may run on any task.
+namespace TankRC::Diagnostics::Journal {
+constexpr std::size_t kCapacityBytes = 32 * 1024;  // ~3 s of PWM input at the 5 ms poll
+
+struct Stats {
+    std::uint32_t records = 0;  // currently held
+    std::uint32_t evicted = 0;  // pushed out by newer records
+    std::uint32_t skipped = 0;  // not recorded because an export was copying the ring
+    std::size_t bytes = 0;
+};
+
+void append(RecordType type, std::uint32_t timeMs, const std::uint8_t* payload, std::size_t length);
+
+void recordRcConfig(const Config::RcConfig& config, std::uint32_t nowMs);
+void recordDrive(const Comms::CommandPacket& packet, std::uint32_t nowMs);
+void recordEvent(const Events::Event& event);
+
+template <std::size_t Channels>
+void recordFrame(const Drivers::RcFrame<Channels>& frame, std::uint32_t nowMs) {
+    std::uint8_t payload[kMaxPayloadBytes];
+    append(RecordType::RcFrame, nowMs, payload, encodeFrame(frame, payload));
+}
+
+// Event route target, e.g. Events::On<Events::LowBattery, recordTopic<Events::LowBattery>>.
+template <typename Topic>
+void recordTopic(const Topic& payload, std::uint32_t timestampMs) {
+    recordEvent(Events::Event::make(payload, timestampMs));
+}
+
+// Writes the file header, the RC config in effect at the oldest record, then every record
+// oldest-first. exportTo() and clear() exclude each other; whichever finds the other
+// running returns false without touching the ring.
+bool exportTo(std::vector<std::uint8_t>& out, std::uint8_t rcChannels);
+bool clear();
+Stats stats();
+}  // namespace TankRC::Diagnostics::Journal
+#endif  // TANKRC_DIAGNOSTICS_JOURNAL_H
@@ -0,0 +1,214 @@
+#pragma once
+#ifndef TANKRC_DIAGNOSTICS_JOURNAL_FORMAT_H
+#define TANKRC_DIAGNOSTICS_JOURNAL_FORMAT_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+
+#include "../events/event_bus.h"
+#include "comms/command_packet.h"
+#include "config/runtime_config.h"
+#include "drivers/rc_frame.h"
+
+// On-the-wire layout of the incident journal, shared by the firmware writer and
+// tools/journal_replay. Fields are written byte by byte, little-endian, so the host never
+// depends on ESP32 struct layout.
+//
+//   file   := header record*
+//   header := "TRJ1" version:u8 rcChannels:u8 reserved:u16
+//   record := type:u8 length:u8 timeMs:u32 payload[length]
+namespace TankRC::Diagnostics::Journal {
+constexpr std::uint8_t kMagic[4] = {'T', 'R', 'J', '1'};
+constexpr std::uint8_t kVersion = 1;
+constexpr std::size_t kFileHeaderBytes = 8;
+constexpr std::size_t kRecordHeaderBytes = 6;
+constexpr std::size_t kMaxPayloadBytes = 255;
+
+enum class RecordType : std::uint8_t {
+    RcConfig = 1,  // calibration + failsafe settings in effect from here on
+    RcFrame = 2,   // raw receiver frame, before filtering
+    Drive = 3,     // packet the pipeline produced from the preceding frame
+    Event = 4,     // Events::Event as dispatched
+};
+
+class ByteWriter {
+  public:
+    explicit ByteWriter(std::uint8_t* out) : out_(out) {}
+    void u8(std::uint8_t value) { out_[size_++] = value; }
+    void u16(std::uint16_t value) {
+        u8(static_cast<std::uint8_t>(value));
+        u8(static_cast<std::uint8_t>(value >> 8));
+    }
+    void u32(std::uint32_t value) {
+        u16(static_cast<std::uint16_t>(value));
+        u16(static_cast<std::uint16_t>(value >> 16));
+    }
+    void f32(float value) {
+        std::uint32_t bits = 0;
+        std::memcpy(&bits, &value, sizeof(bits));
+        u32(bits);
+    }
+    std::size_t size() const { return size_; }
+
+  private:
+    std::uint8_t* out_;
+    std::size_t size_ = 0;
+};
+
+class ByteReader {
+  public:
+    ByteReader(const std::uint8_t* data, std::size_t length) : data_(data), length_(length) {}
+    std::uint8_t u8() { return pos_ < length_ ? data_[pos_++] : (ok_ = false, 0); }
+    std::uint16_t u16() {
+        const std::uint16_t lo = u8();
+        return static_cast<std::uint16_t>(lo | (u8() << 8));
+    }
+    std::uint32_t u32() {
+        const std::uint32_t lo = u16();
+        return lo | (static_cast<std::uint32_t>(u16()) << 16);
+    }
+    float f32() {
+        const std::uint32_t bits = u32();
+        float value = 0.0F;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+    bool ok() const { return ok_; }
+
+  private:
+    const std::uint8_t* data_;
+    std::size_t length_;
+    std::size_t pos_ = 0;
+    bool ok_ = true;
+};
+
+inline std::size_t encodeRcConfig(const Config::RcConfig& config, std::uint8_t* out) {
+    ByteWriter w(out);
+    for (const auto& cal : config.calibration) {
+        w.u16(cal.minUs);
+        w.u16(cal.centerUs);
+        w.u16(cal.maxUs);
+        w.u16(cal.deadbandUs);
+        w.u8(cal.reversed ? 1 : 0);
+    }
+    w.u16(config.failsafe.holdMs);
+    w.u16(config.failsafe.decelerateMs);
+    w.u16(config.failsafe.staleMs);
+    w.u8(config.failsafe.degradedQuality);
+    return w.size();
+}
+
+inline bool decodeRcConfig(const std::uint8_t* data, std::size_t length, Config::RcConfig& config) {
+    ByteReader r(data, length);
+    for (auto& cal : config.calibration) {
+        cal.minUs = r.u16();
+        cal.centerUs = r.u16();
+        cal.maxUs = r.u16();
+        cal.deadbandUs = r.u16();
+        cal.reversed = r.u8() != 0;
+    }
+    config.failsafe.holdMs = r.u16();
+    config.failsafe.decelerateMs = r.u16();
+    config.failsafe.staleMs = r.u16();
+    config.failsafe.degradedQuality = r.u8();
+    return r.ok();
+}
+
+// Widths fit 16 bits; ages saturate at 65535 µs, far past any stale threshold.
+template <std::size_t Channels>
+std::size_t encodeFrame(const Drivers::RcFrame<Channels>& frame, std::uint8_t* out) {
+    static_assert(4 + Channels * 4 <= kMaxPayloadBytes, "frame record too large");
+    ByteWriter w(out);
+    w.u32(static_cast<std::uint32_t>(frame.captureUs));
+    for (std::size_t i = 0; i < Channels; ++i) {
+        w.u16(static_cast<std::uint16_t>(std::min<unsigned long>(frame.widths[i], 0xFFFFUL)));
+        w.u16(static_cast<std::uint16_t>(std::min<unsigned long>(frame.ageUs[i], 0xFFFFUL)));
+    }
+    return w.size();
+}
+
+template <std::size_t Channels>
+bool decodeFrame(const std::uint8_t* data, std::size_t length, Drivers::RcFrame<Channels>& frame) {
+    if (length != 4 + Channels * 4) {
+        return false;
+    }
+    ByteReader r(data, length);
+    frame = {};
+    frame.captureUs = r.u32();
+    for (std::size_t i = 0; i < Channels; ++i) {
+        frame.widths[i] = r.u16();
+        frame.ageUs[i] = r.u16();
+    }
+    return r.ok();
+}
+
+struct DriveRecord {
+    float throttle = 0.0F;
+    float turn = 0.0F;
+    std::uint8_t status = 0;
+    std::uint8_t failsafe = 0;
+    std::uint8_t linkQuality = 0;
+    std::uint8_t flags = 0;  // bit0 rcLinked, bit1 hazard, bit2 aux button
+
+    bool operator==(const DriveRecord& other) const {
+        return throttle == other.throttle && turn == other.turn && status == other.status && failsafe == other.failsafe &&
+               linkQuality == other.linkQuality && flags == other.flags;
+    }
+    bool operator!=(const DriveRecord& other) const { return !(*this == other); }
+};
+
+inline DriveRecord toDriveRecord(const Comms::CommandPacket& packet) {
+    DriveRecord record{};
+    record.throttle = packet.drive.throttle;
+    record.turn = packet.drive.turn;
+    record.status = static_cast<std::uint8_t>(packet.status);
+    record.failsafe = static_cast<std::uint8_t>(packet.failsafe);
+    record.linkQuality = packet.linkQuality;
+    record.flags = static_cast<std::uint8_t>((packet.rcLinked ? 1U : 0U) | (packet.hazard ? 2U : 0U) | (packet.auxButton ? 4U : 0U));
+    return record;
+}
+
+inline std::size_t encodeDrive(const DriveRecord& record, std::uint8_t* out) {
+    ByteWriter w(out);
+    w.f32(record.throttle);
+    w.f32(record.turn);
+    w.u8(record.status);
+    w.u8(record.failsafe);
+    w.u8(record.linkQuality);
+    w.u8(record.flags);
+    return w.size();
+}
+
+inline bool decodeDrive(const std::uint8_t* data, std::size_t length, DriveRecord& record) {
+    ByteReader r(data, length);
+    record.throttle = r.f32();
+    record.turn = r.f32();
+    record.status = r.u8();
+    record.failsafe = r.u8();
+    record.linkQuality = r.u8();
+    record.flags = r.u8();
+    return r.ok();
+}
+
+inline std::size_t encodeEvent(const Events::Event& event, std::uint8_t* out) {
+    ByteWriter w(out);
+    w.u8(static_cast<std::uint8_t>(event.type));
+    for (const auto byte : event.payload) {
+        w.u8(byte);
+    }
+    return w.size();
+}
+
+inline bool decodeEvent(const std::uint8_t* data, std::size_t length, std::uint32_t timeMs, Events::Event& event) {
+    ByteReader r(data, length);
+    event = Events::Event{static_cast<Events::EventType>(r.u8()), timeMs};
+    for (auto& byte : event.payload) {
+        byte = r.u8();
+    }
+    return r.ok() && static_cast<std::size_t>(event.type) < Events::kEventTypeCount;
+}
+}  // namespace TankRC::Diagnostics::Journal
+#endif  // TANKRC_DIAGNOSTICS_JOURNAL_FORMAT_H
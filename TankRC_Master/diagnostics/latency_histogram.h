@@ -0,0 +1,97 @@
+#pragma once
+#ifndef TANKRC_DIAGNOSTICS_LATENCY_HISTOGRAM_H
+#define TANKRC_DIAGNOSTICS_LATENCY_HISTOGRAM_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace TankRC::Diagnostics {
+// Fixed-memory log-linear histogram of microsecond samples: exact below 16 µs, then eight
+// buckets per power of two (<= 12.5% bucket width) up to ~16 s. Percentiles report the
+// bucket midpoint, clamped to the largest value actually seen.
+class LatencyHistogram {
+  public:
+    void record(std::uint32_t us) {
+        ++counts_[bucketFor(us)];
+        ++count_;
+        if (us > max_) {
+            max_ = us;
+        }
+    }
+
+    // Raises the maximum without adding a sample, for worst cases reported out of band.
+    void noteMax(std::uint32_t us) {
+        if (us > max_) {
+            max_ = us;
+        }
+    }
+
+    std::uint32_t percentile(std::uint8_t pct) const {
+        if (count_ == 0) {
+            return 0;
+        }
+        const std::uint64_t target = (static_cast<std::uint64_t>(count_) * pct + 99U) / 100U;
+        std::uint64_t seen = 0;
+        for (std::size_t i = 0; i < kBuckets; ++i) {
+            seen += counts_[i];
+            if (seen >= target && counts_[i] > 0) {
+                const std::uint32_t mid = bucketLow(i) + (bucketWidth(i) - 1U) / 2U;
+                return mid < max_ ? mid : max_;
+            }
+        }
+        return max_;
+    }
+
+    std::uint32_t max() const { return max_; }
+    std::uint32_t count() const { return count_; }
+
+    void reset() {
+        counts_.fill(0);
+        count_ = 0;
+        max_ = 0;
+    }
+
+  private:
+    static constexpr int kSubBits = 3;
+    static constexpr std::uint32_t kSubBuckets = 1U << kSubBits;
+    static constexpr int kMinExponent = kSubBits + 1;  // first power of two split into sub-buckets
+    static constexpr int kMaxExponent = 23;
+    static constexpr std::size_t kLinear = 1U << kMinExponent;
+    static constexpr std::size_t kBuckets = kLinear + (kMaxExponent - kMinExponent + 1) * kSubBuckets;
+
+    static std::size_t bucketFor(std::uint32_t us) {
+        if (us < kLinear) {
+            return us;
+        }
+        const int exponent = 31 - __builtin_clz(us);
+        if (exponent > kMaxExponent) {
+            return kBuckets - 1;
+        }
+        const std::uint32_t sub = (us >> (exponent - kSubBits)) & (kSubBuckets - 1U);
+        return kLinear + static_cast<std::size_t>(exponent - kMinExponent) * kSubBuckets + sub;
+    }
+
+    static std::uint32_t bucketLow(std::size_t index) {
+        if (index < kLinear) {
+            return static_cast<std::uint32_t>(index);
+        }
+        const int exponent = kMinExponent + static_cast<int>((index - kLinear) / kSubBuckets);
+        const auto sub = static_cast<std::uint32_t>((index - kLinear) % kSubBuckets);
+        return (kSubBuckets + sub) << (exponent - kSubBits);
+    }
+
+    static std::uint32_t bucketWidth(std::size_t index) {
+        if (index < kLinear) {
+            return 1U;
+        }
+        const int exponent = kMinExponent + static_cast<int>((index - kLinear) / kSubBuckets);
+        return 1U << (exponent - kSubBits);
+    }
+
+    std::array<std::uint32_t, kBuckets> counts_{};
+    std::uint32_t count_ = 0;
+    std::uint32_t max_ = 0;
+};
+}  // namespace TankRC::Diagnostics
+#endif  // TANKRC_DIAGNOSTICS_LATENCY_HISTOGRAM_H
@@ -0,0 +1,67 @@
+#include "diagnostics/latency_trace.h"
+
+#include <array>
+#include <atomic>
+
+#include "core/snapshot.h"
+
+namespace TankRC::Diagnostics {
+namespace {
+// Recorded on the control task only (RadioLink and SlaveLink both run there). Other tasks
+// read the copies publishLatency() makes and ask for a reset instead of clearing in place.
+std::array<LatencyHistogram, kLatencyStageCount> histograms{};
+std::array<Core::Snapshot<LatencyHistogram>, kLatencyStageCount> published{};
+std::atomic<bool> resetRequested{false};
+}  // namespace
+
+void recordLatency(LatencyStage stage, std::uint32_t us) {
+    const auto index = static_cast<std::size_t>(stage);
+    if (index < kLatencyStageCount) {
+        histograms[index].record(us);
+    }
+}
+
+void noteLatencyMax(LatencyStage stage, std::uint32_t us) {
+    const auto index = static_cast<std::size_t>(stage);
+    if (index < kLatencyStageCount) {
+        histograms[index].noteMax(us);
+    }
+}
+
+void publishLatency() {
+    if (resetRequested.exchange(false)) {
+        for (auto& histogram : histograms) {
+            histogram.reset();
+        }
+    }
+    for (std::size_t i = 0; i < kLatencyStageCount; ++i) {
+        published[i].write(histograms[i]);
+    }
+}
+
+LatencyHistogram latencyHistogram(LatencyStage stage) {
+    const auto index = static_cast<std::size_t>(stage);
+    return published[index < kLatencyStageCount ? index : 0].read();
+}
+
+void resetLatency() {
+    resetRequested = true;
+}
+
+const char* toString(LatencyStage stage) {
+    switch (stage) {
+        case LatencyStage::Input:
+            return "input";
+        case LatencyStage::Dispatch:
+            return "dispatch";
+        case LatencyStage::Wire:
+            return "wire";
+        case LatencyStage::SlaveApply:
+            return "slave";
+        case LatencyStage::Total:
+            return "total";
+        default:
+            return "unknown";
+    }
+}
+}  // namespace TankRC::Diagnostics
@@ -0,0 +1,36 @@
+#pragma once
+#ifndef TANKRC_DIAGNOSTICS_LATENCY_TRACE_H
+#define TANKRC_DIAGNOSTICS_LATENCY_TRACE_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "diagnostics/latency_histogram.h"
+
+// Input-to-actuation latency, split by pipeline stage. Master stages are measured on the
+// master clock; the slave reports its own receive-to-PWM time in each status frame, so no
+// shared time base is needed to sum them.
+namespace TankRC::Diagnostics {
+enum class LatencyStage : std::uint8_t {
+    Input,       // receiver edge -> RadioLink::poll()
+    Dispatch,    // poll -> command frame written to the slave UART
+    Wire,        // command frame serialization time at the link baud rate
+    SlaveApply,  // slave frame received -> MotorDriver PWM write
+    Total,
+    Count,
+};
+
+constexpr std::size_t kLatencyStageCount = static_cast<std::size_t>(LatencyStage::Count);
+
+// Recording and publishLatency() belong to the control task.
+void recordLatency(LatencyStage stage, std::uint32_t us);
+void noteLatencyMax(LatencyStage stage, std::uint32_t us);
+// Copies the histograms out for other tasks and carries out a pending reset.
+void publishLatency();
+// Safe from any task: the last published copy.
+LatencyHistogram latencyHistogram(LatencyStage stage);
+// Clears on the control task's next publishLatency().
+void resetLatency();
+const char* toString(LatencyStage stage);
+}  // namespace TankRC::Diagnostics
+#endif  // TANKRC_DIAGNOSTICS_LATENCY_TRACE_H
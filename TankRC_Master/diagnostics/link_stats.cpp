@@ -0,0 +1,81 @@
+#include "diagnostics/link_stats.h"
+
+#include <array>
+
+#include "core/snapshot.h"
+
+namespace TankRC::Diagnostics {
+namespace {
+// SlaveLink stores from the control task; the console, web handlers and session log read
+// from other tasks and cores.
+std::array<Core::Snapshot<Comms::SlaveProtocol::LinkCounters>, kLinkDirectionCount> counters{};
+Core::Snapshot<ConfigSync> configState;
+Core::Snapshot<LinkTraffic> trafficState;
+Core::Snapshot<LinkQuality> qualityState;
+Core::Snapshot<SlaveClock> clockState;
+Core::Snapshot<LinkProtocol> protocolState;
+}  // namespace
+
+void storeLinkCounters(LinkDirection direction, const Comms::SlaveProtocol::LinkCounters& value) {
+    const auto index = static_cast<std::size_t>(direction);
+    if (index < kLinkDirectionCount) {
+        counters[index].write(value);
+    }
+}
+
+Comms::SlaveProtocol::LinkCounters linkCounters(LinkDirection direction) {
+    const auto index = static_cast<std::size_t>(direction);
+    return counters[index < kLinkDirectionCount ? index : 0].read();
+}
+
+void storeConfigSync(const ConfigSync& sync) {
+    configState.write(sync);
+}
+
+ConfigSync configSync() {
+    return configState.read();
+}
+
+void storeLinkTraffic(const LinkTraffic& traffic) {
+    trafficState.write(traffic);
+}
+
+LinkTraffic linkTraffic() {
+    return trafficState.read();
+}
+
+void storeLinkQuality(const LinkQuality& quality) {
+    qualityState.write(quality);
+}
+
+LinkQuality linkQuality() {
+    return qualityState.read();
+}
+
+void storeSlaveClock(const SlaveClock& clock) {
+    clockState.write(clock);
+}
+
+SlaveClock slaveClock() {
+    return clockState.read();
+}
+
+void storeLinkProtocol(const LinkProtocol& protocol) {
+    protocolState.write(protocol);
+}
+
+LinkProtocol linkProtocol() {
+    return protocolState.read();
+}
+
+const char* toString(LinkDirection direction) {
+    switch (direction) {
+        case LinkDirection::ToSlave:
+            return "toSlave";
+        case LinkDirection::FromSlave:
+            return "fromSlave";
+        default:
+            return "?";
+    }
+}
+}  // namespace TankRC::Diagnostics
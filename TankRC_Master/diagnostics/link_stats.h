@@ -0,0 +1,108 @@
+#pragma once
+#ifndef TANKRC_DIAGNOSTICS_LINK_STATS_H
+#define TANKRC_DIAGNOSTICS_LINK_STATS_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "../link/slave_protocol.h"
+
+// Master <-> slave UART health. Each side counts what it receives; the slave's view of the
+// master's frames arrives in its status payload, so both directions are readable here.
+// Only SlaveLink stores; the getters return whole copies and may be called from any task.
+namespace TankRC::Diagnostics {
+enum class LinkDirection : std::uint8_t {
+    ToSlave,    // counted by the slave
+    FromSlave,  // counted by SlaveLink on the master
+    Count,
+};
+
+constexpr std::size_t kLinkDirectionCount = static_cast<std::size_t>(LinkDirection::Count);
+
+// Round-trip bucket upper bounds, in µs; the last bucket collects everything slower.
+constexpr std::array<std::uint32_t, 7> kRttBoundsUs{{250, 500, 1000, 2000, 5000, 10000, 20000}};
+constexpr std::size_t kRttBuckets = kRttBoundsUs.size() + 1;
+
+// Ping/pong probe results. The link reads degraded while it is still up but losing pings,
+// slow or jittery, long before the status timeout takes it offline.
+struct LinkQuality {
+    bool online = false;
+    bool degraded = false;
+    std::uint32_t rttUs = 0;       // latest round trip, slave turnaround excluded
+    std::uint32_t minRttUs = 0;
+    std::uint32_t maxRttUs = 0;
+    std::uint32_t jitterUs = 0;    // RFC 3550 smoothed |RTT change|
+    std::uint8_t lossPercent = 0;  // unanswered pings among the most recent 64
+    std::uint32_t sent = 0;
+    std::uint32_t answered = 0;
+    std::uint32_t lost = 0;
+    std::array<std::uint32_t, kRttBuckets> histogram{};
+};
+
+// Slave clock relative to the master's, estimated from ping/pong timestamps.
+struct SlaveClock {
+    bool synced = false;
+    std::int32_t offsetUs = 0;     // slave micros() minus master micros(), modulo 2^32
+    float driftPpm = 0.0F;         // how fast the slave clock gains on the master's
+    std::int32_t residualUs = 0;   // last filtered sample versus the prediction
+    std::uint32_t bestRttUs = 0;   // RTT of that sample
+    std::uint32_t updates = 0;
+    std::uint32_t resyncs = 0;     // estimate restarted, e.g. after the slave rebooted
+};
+
+// Master -> slave bandwidth over the last full second. savedBytesPerSec compares the
+// command bytes actually sent with one command frame per control tick.
+struct LinkTraffic {
+    std::uint32_t txBytesPerSec = 0;
+    std::uint32_t commandBytesPerSec = 0;
+    std::uint32_t savedBytesPerSec = 0;
+    std::uint32_t commandsSent = 0;        // totals since boot
+    std::uint32_t commandsSuppressed = 0;  // control ticks whose command stayed within epsilon
+};
+
+// Config delivery to the slave: the hash SlaveLink last pushed versus the one the slave
+// reports running.
+struct ConfigSync {
+    std::uint32_t hash = 0;
+    std::uint32_t slaveHash = 0;
+    bool pending = false;  // waiting for an ack; retransmitting with backoff
+    std::uint32_t sends = 0;
+    std::uint32_t retries = 0;
+    std::uint32_t nacks = 0;
+    std::uint32_t resyncs = 0;  // slave status showed a different hash (e.g. after a reset)
+};
+
+// Hello exchange with the slave, repeated after every link loss and slave reboot.
+struct LinkProtocol {
+    bool pending = false;     // Hello sent, no reply yet
+    bool replied = false;     // the slave answered the current Hello
+    bool compatible = false;  // both ends accept each other; only then are encodings used
+    Comms::SlaveProtocol::HelloResult result = Comms::SlaveProtocol::HelloResult::Ok;
+    std::uint16_t version = 0;  // this firmware's
+    std::uint16_t slaveVersion = 0;
+    std::uint16_t slaveMinVersion = 0;
+    std::uint8_t encodings = 0;  // EncodingFlags in use, i.e. listed by both ends
+    std::uint16_t slaveFeatures = 0;
+    std::uint8_t configBytes = 0;
+    std::uint8_t slaveConfigBytes = 0;
+    std::uint32_t hellos = 0;
+    std::uint32_t mismatches = 0;    // replies that ended incompatible
+    std::uint32_t lengthErrors = 0;  // slave frames dropped because their size did not match
+};
+
+void storeLinkCounters(LinkDirection direction, const Comms::SlaveProtocol::LinkCounters& counters);
+Comms::SlaveProtocol::LinkCounters linkCounters(LinkDirection direction);
+const char* toString(LinkDirection direction);
+void storeConfigSync(const ConfigSync& sync);
+ConfigSync configSync();
+void storeLinkTraffic(const LinkTraffic& traffic);
+LinkTraffic linkTraffic();
+void storeLinkQuality(const LinkQuality& quality);
+LinkQuality linkQuality();
+void storeSlaveClock(const SlaveClock& clock);
+SlaveClock slaveClock();
+void storeLinkProtocol(const LinkProtocol& protocol);
+LinkProtocol linkProtocol();
+}  // namespace TankRC::Diagnostics
+#endif  // TANKRC_DIAGNOSTICS_LINK_STATS_H
@@ -0,0 +1,47 @@
+#include "diagnostics/slave_telemetry.h"
+
+#include <esp_system.h>
+
+#include "core/snapshot.h"
+
+namespace TankRC::Diagnostics {
+namespace {
+// Written by SlaveLink on the control task, read by the session log and web handlers.
+Core::Snapshot<SlaveTelemetry> telemetryState;
+}  // namespace
+
+void storeSlaveTelemetry(const SlaveTelemetry& telemetry) {
+    telemetryState.write(telemetry);
+}
+
+SlaveTelemetry slaveTelemetry() {
+    return telemetryState.read();
+}
+
+const char* resetReasonName(std::uint8_t reason) {
+    switch (static_cast<esp_reset_reason_t>(reason)) {
+        case ESP_RST_POWERON:
+            return "power-on";
+        case ESP_RST_EXT:
+            return "external";
+        case ESP_RST_SW:
+            return "software";
+        case ESP_RST_PANIC:
+            return "panic";
+        case ESP_RST_INT_WDT:
+            return "interrupt-wdt";
+        case ESP_RST_TASK_WDT:
+            return "task-wdt";
+        case ESP_RST_WDT:
+            return "wdt";
+        case ESP_RST_DEEPSLEEP:
+            return "deep-sleep";
+        case ESP_RST_BROWNOUT:
+            return "brownout";
+        case ESP_RST_SDIO:
+            return "sdio";
+        default:
+            return "unknown";
+    }
+}
+}  // namespace TankRC::Diagnostics
@@ -0,0 +1,29 @@
+#pragma once
+#ifndef TANKRC_DIAGNOSTICS_SLAVE_TELEMETRY_H
+#define TANKRC_DIAGNOSTICS_SLAVE_TELEMETRY_H
+
+#include <array>
+#include <cstdint>
+
+#include "../link/slave_protocol.h"
+
+// Latest Telemetry groups from the slave. Each group arrives at its own subscribed rate, so
+// every group carries the time it was sampled, converted to the master's millis().
+namespace TankRC::Diagnostics {
+struct SlaveTelemetry {
+    Comms::SlaveProtocol::TelemetryMotors motors{};
+    Comms::SlaveProtocol::TelemetryPid pid{};
+    Comms::SlaveProtocol::TelemetryLoop loop{};
+    Comms::SlaveProtocol::TelemetryI2c i2c{};
+    Comms::SlaveProtocol::TelemetrySystem system{};
+    std::array<std::uint32_t, Comms::SlaveProtocol::kTelemetryGroupCount> sampledMs{};  // 0 = never
+    std::uint32_t frames = 0;
+    bool clockSynced = false;  // false: sampledMs is the arrival time, not yet clock-corrected
+};
+
+void storeSlaveTelemetry(const SlaveTelemetry& telemetry);
+SlaveTelemetry slaveTelemetry();
+// esp_reset_reason_t as reported by the slave, e.g. "brownout".
+const char* resetReasonName(std::uint8_t reason);
+}  // namespace TankRC::Diagnostics
+#endif  // TANKRC_DIAGNOSTICS_SLAVE_TELEMETRY_H
@@ -0,0 +1,21 @@
+#pragma once
+#ifndef TANKRC_DRIVERS_RC_FRAME_H
+#define TANKRC_DRIVERS_RC_FRAME_H
+
+#include <cstddef>
+
+namespace TankRC::Drivers {
+// One snapshot of every receiver channel. The channel count is fixed per backend so
+// PWM builds only pay for six slots while serial receivers get the full 16.
+template <std::size_t Channels>
+struct RcFrame {
+    static constexpr std::size_t kChannelCount = Channels;
+
+    float normalized[Channels]{};      // -1..1, filled in by Channels::RcCalibration
+    unsigned long widths[Channels]{};  // pulse width in µs, 0 when the channel never reported
+    unsigned long ageUs[Channels]{};   // captureUs minus the time the sample arrived; drivers
+                                       // leave the stale cut-off to RcSignalQuality
+    unsigned long captureUs = 0;
+};
+}  // namespace TankRC::Drivers
+#endif  // TANKRC_DRIVERS_RC_FRAME_H
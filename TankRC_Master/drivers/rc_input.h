@@ -0,0 +1,29 @@
+#pragma once
+#ifndef TANKRC_DRIVERS_RC_INPUT_H
+#define TANKRC_DRIVERS_RC_INPUT_H
+
+#include "config/build_config.h"
+
+// Selects the receiver backend at compile time (see TANKRC_RC_PROTOCOL).
+#if TANKRC_RC_PROTOCOL == TANKRC_RC_PROTOCOL_PWM
+#include "drivers/rc_receiver.h"
+#else
+#include "drivers/serial_rc_receiver.h"
+#endif
+
+namespace TankRC::Drivers {
+#if TANKRC_RC_PROTOCOL == TANKRC_RC_PROTOCOL_PWM
+using RcInput = RcReceiver;
+#elif TANKRC_RC_PROTOCOL == TANKRC_RC_PROTOCOL_SBUS
+using RcInput = SerialRcReceiver<RcProtocols::SbusDecoder>;
+#elif TANKRC_RC_PROTOCOL == TANKRC_RC_PROTOCOL_IBUS
+using RcInput = SerialRcReceiver<RcProtocols::IbusDecoder>;
+#elif TANKRC_RC_PROTOCOL == TANKRC_RC_PROTOCOL_CRSF
+using RcInput = SerialRcReceiver<RcProtocols::CrsfDecoder>;
+#else
+#error "Unknown TANKRC_RC_PROTOCOL"
+#endif
+
+using RcInputFrame = RcInput::Frame;
+}  // namespace TankRC::Drivers
+#endif  // TANKRC_DRIVERS_RC_INPUT_H
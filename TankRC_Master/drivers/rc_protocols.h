@@ -0,0 +1,225 @@
+#pragma once
+#ifndef TANKRC_DRIVERS_RC_PROTOCOLS_H
+#define TANKRC_DRIVERS_RC_PROTOCOLS_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Streaming decoders for single-wire serial receivers. Each decoder is fed one byte at a
+// time and reports when a complete, validated frame has been latched. They only depend on
+// the standard library so they can be driven from captured byte streams on the host.
+namespace TankRC::Drivers::RcProtocols {
+namespace detail {
+// SBUS and CRSF share the same 11-bit channel packing and 172..1811 tick range.
+template <std::size_t Count>
+void unpack11(const std::uint8_t* data, std::array<std::uint16_t, Count>& out) {
+    std::uint32_t bits = 0;
+    int bitCount = 0;
+    std::size_t index = 0;
+    for (auto& value : out) {
+        while (bitCount < 11) {
+            bits |= static_cast<std::uint32_t>(data[index++]) << bitCount;
+            bitCount += 8;
+        }
+        value = static_cast<std::uint16_t>(bits & 0x07FFU);
+        bits >>= 11;
+        bitCount -= 11;
+    }
+}
+
+// 172 -> 988 µs, 992 -> 1500 µs, 1811 -> 2012 µs.
+constexpr std::uint16_t ticksToUs(std::uint16_t ticks) {
+    return static_cast<std::uint16_t>((static_cast<std::uint32_t>(ticks) * 5U) / 8U + 880U);
+}
+}  // namespace detail
+
+// Futaba SBUS: 100000 baud 8E2 inverted, 25-byte frames at 7-14 ms.
+class SbusDecoder {
+  public:
+    static constexpr std::size_t kChannelCount = 16;
+    static constexpr unsigned long kBaud = 100000UL;
+    static constexpr bool kInverted = true;
+    static constexpr bool kEvenParityTwoStop = true;
+
+    bool push(std::uint8_t byte) {
+        if (pos_ == 0 && byte != kHeader) {
+            return false;
+        }
+        buffer_[pos_++] = byte;
+        if (pos_ < kFrameSize) {
+            return false;
+        }
+        pos_ = 0;
+        // SBUS2 receivers rotate the footer through 0x04/0x14/0x24/0x34.
+        const std::uint8_t footer = buffer_[kFrameSize - 1];
+        if (footer != 0x00 && (footer & 0xCFU) != 0x04) {
+            ++errors_;
+            return false;
+        }
+        std::array<std::uint16_t, kChannelCount> ticks{};
+        detail::unpack11(&buffer_[1], ticks);
+        for (std::size_t i = 0; i < kChannelCount; ++i) {
+            channels_[i] = detail::ticksToUs(ticks[i]);
+        }
+        const std::uint8_t flags = buffer_[kFrameSize - 2];
+        frameLost_ = (flags & kFlagFrameLost) != 0;
+        failsafe_ = (flags & kFlagFailsafe) != 0;
+        ++frames_;
+        return true;
+    }
+
+    void reset() { pos_ = 0; }
+    const std::uint16_t* channelsUs() const { return channels_.data(); }
+    bool failsafe() const { return failsafe_; }
+    bool frameLost() const { return frameLost_; }
+    std::uint32_t frames() const { return frames_; }
+    std::uint32_t errors() const { return errors_; }
+
+  private:
+    static constexpr std::size_t kFrameSize = 25;
+    static constexpr std::uint8_t kHeader = 0x0F;
+    static constexpr std::uint8_t kFlagFrameLost = 1U << 2;
+    static constexpr std::uint8_t kFlagFailsafe = 1U << 3;
+
+    std::array<std::uint8_t, kFrameSize> buffer_{};
+    std::size_t pos_ = 0;
+    std::array<std::uint16_t, kChannelCount> channels_{};
+    bool failsafe_ = false;
+    bool frameLost_ = false;
+    std::uint32_t frames_ = 0;
+    std::uint32_t errors_ = 0;
+};
+
+// FlySky iBUS: 115200 baud 8N1, 32-byte frames every 7 ms with a 16-bit sum checksum.
+class IbusDecoder {
+  public:
+    static constexpr std::size_t kChannelCount = 14;
+    static constexpr unsigned long kBaud = 115200UL;
+    static constexpr bool kInverted = false;
+    static constexpr bool kEvenParityTwoStop = false;
+
+    bool push(std::uint8_t byte) {
+        if (pos_ == 0 && byte != kFrameSize) {
+            return false;
+        }
+        if (pos_ == 1 && byte != kCommand) {
+            pos_ = 0;
+            return push(byte);
+        }
+        buffer_[pos_++] = byte;
+        if (pos_ < kFrameSize) {
+            return false;
+        }
+        pos_ = 0;
+        std::uint16_t sum = 0xFFFF;
+        for (std::size_t i = 0; i < kFrameSize - 2; ++i) {
+            sum = static_cast<std::uint16_t>(sum - buffer_[i]);
+        }
+        const std::uint16_t expected =
+            static_cast<std::uint16_t>(buffer_[kFrameSize - 2] | (buffer_[kFrameSize - 1] << 8));
+        if (sum != expected) {
+            ++errors_;
+            return false;
+        }
+        for (std::size_t i = 0; i < kChannelCount; ++i) {
+            const std::size_t offset = 2 + i * 2;
+            channels_[i] = static_cast<std::uint16_t>((buffer_[offset] | (buffer_[offset + 1] << 8)) & 0x0FFF);
+        }
+        ++frames_;
+        return true;
+    }
+
+    void reset() { pos_ = 0; }
+    const std::uint16_t* channelsUs() const { return channels_.data(); }
+    // iBUS has no failsafe flag; receivers either stop transmitting or send failsafe values.
+    bool failsafe() const { return false; }
+    std::uint32_t frames() const { return frames_; }
+    std::uint32_t errors() const { return errors_; }
+
+  private:
+    static constexpr std::size_t kFrameSize = 0x20;
+    static constexpr std::uint8_t kCommand = 0x40;
+
+    std::array<std::uint8_t, kFrameSize> buffer_{};
+    std::size_t pos_ = 0;
+    std::array<std::uint16_t, kChannelCount> channels_{};
+    std::uint32_t frames_ = 0;
+    std::uint32_t errors_ = 0;
+};
+
+// TBS Crossfire / ELRS CRSF: 420000 baud 8N1, [sync][len][type][payload][crc8].
+// Only RC_CHANNELS_PACKED frames are latched; every other frame type is skipped.
+class CrsfDecoder {
+  public:
+    static constexpr std::size_t kChannelCount = 16;
+    static constexpr unsigned long kBaud = 420000UL;
+    static constexpr bool kInverted = false;
+    static constexpr bool kEvenParityTwoStop = false;
+
+    bool push(std::uint8_t byte) {
+        if (pos_ == 0) {
+            if (byte != kSyncFc && byte != kSyncTx && byte != kSyncRx) {
+                return false;
+            }
+        } else if (pos_ == 1 && (byte < kMinLength || byte > kMaxLength)) {
+            pos_ = 0;
+            return push(byte);
+        }
+        buffer_[pos_++] = byte;
+        if (pos_ < 2 || pos_ < static_cast<std::size_t>(buffer_[1]) + 2) {
+            return false;
+        }
+        const std::size_t length = buffer_[1];
+        pos_ = 0;
+        if (crc8(&buffer_[2], length - 1) != buffer_[length + 1]) {
+            ++errors_;
+            return false;
+        }
+        if (buffer_[2] != kTypeRcChannels || length != kRcChannelsPayload + 2) {
+            return false;
+        }
+        std::array<std::uint16_t, kChannelCount> ticks{};
+        detail::unpack11(&buffer_[3], ticks);
+        for (std::size_t i = 0; i < kChannelCount; ++i) {
+            channels_[i] = detail::ticksToUs(ticks[i]);
+        }
+        ++frames_;
+        return true;
+    }
+
+    void reset() { pos_ = 0; }
+    const std::uint16_t* channelsUs() const { return channels_.data(); }
+    bool failsafe() const { return false; }
+    std::uint32_t frames() const { return frames_; }
+    std::uint32_t errors() const { return errors_; }
+
+  private:
+    static constexpr std::uint8_t kSyncFc = 0xC8;
+    static constexpr std::uint8_t kSyncTx = 0xEE;
+    static constexpr std::uint8_t kSyncRx = 0xEA;
+    static constexpr std::uint8_t kMinLength = 2;
+    static constexpr std::uint8_t kMaxLength = 62;
+    static constexpr std::uint8_t kTypeRcChannels = 0x16;
+    static constexpr std::size_t kRcChannelsPayload = 22;
+
+    // CRC-8/DVB-S2 (poly 0xD5) over type + payload.
+    static std::uint8_t crc8(const std::uint8_t* data, std::size_t length) {
+        std::uint8_t crc = 0;
+        for (std::size_t i = 0; i < length; ++i) {
+            crc ^= data[i];
+            for (int bit = 0; bit < 8; ++bit) {
+                crc = (crc & 0x80U) ? static_cast<std::uint8_t>((crc << 1) ^ 0xD5U) : static_cast<std::uint8_t>(crc << 1);
+            }
+        }
+        return crc;
+    }
+
+    std::array<std::uint8_t, kMaxLength + 2> buffer_{};
+    std::size_t pos_ = 0;
+    std::array<std::uint16_t, kChannelCount> channels_{};
+    std::uint32_t frames_ = 0;
+    std::uint32_t errors_ = 0;
+};
+}  // namespace TankRC::Drivers::RcProtocols
+#endif  // TANKRC_DRIVERS_RC_PROTOCOLS_H
@@ -4,30 +4,71 @@
 
 namespace TankRC::Drivers {
 namespace {
-constexpr unsigned long kPulseMin = 1000UL;
-constexpr unsigned long kPulseMax = 2000UL;
-constexpr unsigned long kPulseMid = (kPulseMin + kPulseMax) / 2UL;
-constexpr unsigned long kPulseRange = (kPulseMax - kPulseMin);
-
-float normalizePulse(unsigned long width) {
-    if (width == 0) {
-        return 0.0F;
-    }
-    if (width < kPulseMin) {
-        width = kPulseMin;
-    } else if (width > kPulseMax) {
-        width = kPulseMax;
-    }
-    const float centered = static_cast<float>(width) - static_cast<float>(kPulseMid);
-    return centered / static_cast<float>(kPulseRange) * 2.0F;
-}
+// Anything outside this window is line noise or a frame gap, not a servo pulse.
+constexpr unsigned long kPulseAcceptMin = 500UL;
+constexpr unsigned long kPulseAcceptMax = 2500UL;
 }  // namespace
 
+void IRAM_ATTR RcReceiver::handleEdge(void* arg) {
+    auto* channel = static_cast<ChannelCapture*>(arg);
+    const unsigned long now = micros();
+    if (digitalRead(channel->pin) == HIGH) {
+        channel->riseUs = now;
+        channel->high = true;
+        return;
+    }
+    if (!channel->high) {
+        return;
+    }
+    channel->high = false;
+    const unsigned long width = now - channel->riseUs;
+    if (width < kPulseAcceptMin || width > kPulseAcceptMax) {
+        return;
+    }
+    const std::uint8_t next = channel->active ^ 1U;
+    channel->slots[next].width = width;
+    channel->slots[next].fallUs = now;
+    channel->active = next;
+    channel->valid = true;
+}
+
+RcReceiver::PulseSample RcReceiver::snapshot(const ChannelCapture& channel) {
+    PulseSample sample{};
+    // The ISR only ever writes the inactive slot; re-check `active` in case two edges
+    // landed while we were copying and the slot we read was recycled underneath us.
+    std::uint8_t index = channel.active;
+    for (int attempt = 0; attempt < 3; ++attempt) {
+        sample.width = channel.slots[index].width;
+        sample.fallUs = channel.slots[index].fallUs;
+        const std::uint8_t after = channel.active;
+        if (after == index) {
+            break;
+        }
+        index = after;
+    }
+    return sample;
+}
+
+void RcReceiver::detachAll() {
+    for (auto& channel : channels_) {
+        if (channel.pin >= 0) {
+            detachInterrupt(digitalPinToInterrupt(channel.pin));
+        }
+        channel.pin = -1;
+        channel.valid = false;
+        channel.high = false;
+    }
+}
+
 void RcReceiver::begin(const int* pins, std::size_t count) {
+    detachAll();
     for (std::size_t i = 0; i < kChannelCount; ++i) {
-        pins_[i] = (i < count) ? pins[i] : -1;
-        if (pins_[i] >= 0) {
-            pinMode(pins_[i], INPUT);
+        auto& channel = channels_[i];
+        channel.pin = (i < count) ? pins[i] : -1;
+        channel.active = 0;
+        if (channel.pin >= 0) {
+            pinMode(channel.pin, INPUT);
+            attachInterruptArg(digitalPinToInterrupt(channel.pin), handleEdge, &channel, CHANGE);
         }
     }
     initialized_ = true;
@@ -41,12 +82,13 @@ RcReceiver::Frame RcReceiver::readFrame() {
     }
 
     for (std::size_t i = 0; i < kChannelCount; ++i) {
-        if (pins_[i] < 0) {
+        const auto& channel = channels_[i];
+        if (channel.pin < 0 || !channel.valid) {
             continue;
         }
-        const unsigned long width = pulseIn(pins_[i], HIGH, 25000UL);
-        frame.widths[i] = width;
-        frame.normalized[i] = normalizePulse(width);
+        const PulseSample sample = snapshot(channel);
+        frame.ageUs[i] = frame.captureUs - sample.fallUs;
+        frame.widths[i] = sample.width;
     }
     return frame;
 }
@@ -3,23 +3,44 @@
 #define TANKRC_DRIVERS_RC_RECEIVER_H
 
 #include <cstddef>
+#include <cstdint>
+
+#include "drivers/rc_frame.h"
 
 namespace TankRC::Drivers {
 class RcReceiver {
   public:
     static constexpr std::size_t kChannelCount = 6;
+    // Every channel that has seen a pulse reports its last width and age; whether that is
+    // too old is rc.failsafe.staleMs's call, made in Channels::RcSignalQuality.
 
-    struct Frame {
-        float normalized[kChannelCount]{};
-        unsigned long widths[kChannelCount]{};
-        unsigned long captureUs = 0;
-    };
+    using Frame = RcFrame<kChannelCount>;
 
     void begin(const int* pins, std::size_t count);
     Frame readFrame();
 
   private:
-    int pins_[kChannelCount]{};
+    struct PulseSample {
+        unsigned long width = 0;
+        unsigned long fallUs = 0;
+    };
+
+    // Written only from the GPIO ISR: each falling edge fills the inactive slot and then
+    // flips `active`, so readers always see a complete sample without masking interrupts.
+    struct ChannelCapture {
+        int pin = -1;
+        volatile unsigned long riseUs = 0;
+        volatile bool high = false;
+        volatile PulseSample slots[2]{};
+        volatile std::uint8_t active = 0;
+        volatile bool valid = false;
+    };
+
+    static void handleEdge(void* arg);
+    static PulseSample snapshot(const ChannelCapture& channel);
+    void detachAll();
+
+    ChannelCapture channels_[kChannelCount]{};
     bool initialized_ = false;
 };
 }  // namespace TankRC::Drivers
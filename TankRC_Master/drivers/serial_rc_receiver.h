@@ -0,0 +1,78 @@
+#pragma once
+#ifndef TANKRC_DRIVERS_SERIAL_RC_RECEIVER_H
+#define TANKRC_DRIVERS_SERIAL_RC_RECEIVER_H
+
+#include <Arduino.h>
+#include <HardwareSerial.h>
+
+#include "drivers/rc_frame.h"
+#include "drivers/rc_protocols.h"
+
+namespace TankRC::Drivers {
+// Serial (single-wire) receiver backend. The decoder decides the channel count, so an
+// SBUS build gets 16-channel frames while the PWM receiver keeps its six.
+template <typename Decoder>
+class SerialRcReceiver {
+  public:
+    static constexpr std::size_t kChannelCount = Decoder::kChannelCount;
+    // Channels carry the last frame's values and age; rc.failsafe.staleMs decides, in
+    // Channels::RcSignalQuality, when that is too old.
+
+    using Frame = RcFrame<kChannelCount>;
+
+    explicit SerialRcReceiver(HardwareSerial* serial = &Serial2) : serial_(serial) {}
+
+    // Only the first pin is used: it is the UART RX line the receiver is wired to.
+    void begin(const int* pins, std::size_t count) {
+        if (!serial_) {
+            return;
+        }
+        const int rxPin = (pins && count > 0) ? pins[0] : -1;
+        if (initialized_) {
+            serial_->end();
+        }
+        serial_->begin(Decoder::kBaud,
+                       Decoder::kEvenParityTwoStop ? SERIAL_8E2 : SERIAL_8N1,
+                       rxPin,
+                       -1,
+                       Decoder::kInverted);
+        decoder_.reset();
+        hasFrame_ = false;
+        initialized_ = rxPin >= 0;
+    }
+
+    Frame readFrame() {
+        Frame frame{};
+        if (initialized_) {
+            // Only drains what the UART driver already buffered, so this never blocks.
+            while (serial_->available() > 0) {
+                if (decoder_.push(static_cast<std::uint8_t>(serial_->read()))) {
+                    lastFrameUs_ = micros();
+                    hasFrame_ = true;
+                }
+            }
+        }
+        frame.captureUs = micros();
+        if (!hasFrame_ || decoder_.failsafe()) {
+            return frame;
+        }
+        const unsigned long age = frame.captureUs - lastFrameUs_;
+        const std::uint16_t* channels = decoder_.channelsUs();
+        for (std::size_t i = 0; i < kChannelCount; ++i) {
+            frame.ageUs[i] = age;
+            frame.widths[i] = channels[i];
+        }
+        return frame;
+    }
+
+    const Decoder& decoder() const { return decoder_; }
+
+  private:
+    HardwareSerial* serial_ = nullptr;
+    Decoder decoder_{};
+    unsigned long lastFrameUs_ = 0;
+    bool hasFrame_ = false;
+    bool initialized_ = false;
+};
+}  // namespace TankRC::Drivers
+#endif  // TANKRC_DRIVERS_SERIAL_RC_RECEIVER_H
@@ -1,12 +1,13 @@
 #include "hal/hal.h"
 
 #include <Arduino.h>
+#include <iterator>
 
 #include "config/hardware_map.h"
 
 namespace TankRC::Hal {
 namespace {
-Drivers::RcReceiver receiver;
+Drivers::RcInput receiver;
 int speakerPin = -1;
 }  // namespace
 
@@ -16,12 +17,12 @@ void initializePlatform() {
 }
 
 void begin(const Config::RuntimeConfig& config) {
-    receiver.begin(config.rc.channelPins, Drivers::RcReceiver::kChannelCount);
+    receiver.begin(config.rc.channelPins, std::size(config.rc.channelPins));
     setSpeakerPin(config.pins.speaker);
 }
 
 void applyConfig(const Config::RuntimeConfig& config) {
-    receiver.begin(config.rc.channelPins, Drivers::RcReceiver::kChannelCount);
+    receiver.begin(config.rc.channelPins, std::size(config.rc.channelPins));
     setSpeakerPin(config.pins.speaker);
 }
 
@@ -37,7 +38,7 @@ void toggleStatusLed() {
     digitalWrite(Pins::STATUS_LED, !digitalRead(Pins::STATUS_LED));
 }
 
-Drivers::RcReceiver::Frame readRcFrame() {
+Drivers::RcInputFrame readRcFrame() {
     return receiver.readFrame();
 }
 
@@ -3,7 +3,7 @@
 #include <cstdint>
 
 #include "config/runtime_config.h"
-#include "drivers/rc_receiver.h"
+#include "drivers/rc_input.h"
 
 namespace TankRC::Hal {
 void initializePlatform();
@@ -15,7 +15,7 @@ void delayMs(std::uint32_t ms);
 
 void toggleStatusLed();
 
-Drivers::RcReceiver::Frame readRcFrame();
+Drivers::RcInputFrame readRcFrame();
 
 void setSpeakerPin(int pin);
 void writeSpeakerLevel(std::uint8_t duty);
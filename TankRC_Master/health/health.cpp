@@ -14,6 +14,16 @@ void setStatus(HealthCode code, const char* message, std::uint32_t timestampMs)
     status.lastChangeMs = ts;
 }
 
+void setRcLinkQuality(std::uint8_t percent) {
+    status.rcLinkQuality = percent;
+}
+
+void setEventBackpressure(std::uint32_t criticalDropped, std::uint32_t dropped, std::uint32_t coalesced) {
+    status.criticalEventsDropped = criticalDropped;
+    status.eventsDropped = dropped;
+    status.eventsCoalesced = coalesced;
+}
+
 const HealthStatus& getStatus() {
     return status;
 }
@@ -30,6 +40,16 @@ const char* toString(HealthCode code) {
             return "Low Battery";
         case HealthCode::SensorFailure:
             return "Sensor Failure";
+        case HealthCode::RcLinkDegraded:
+            return "RC Link Degraded";
+        case HealthCode::EventOverflow:
+            return "Event Overflow";
+        case HealthCode::SlaveLinkLost:
+            return "Slave Link Lost";
+        case HealthCode::SlaveLinkDegraded:
+            return "Slave Link Degraded";
+        case HealthCode::SlaveProtocolMismatch:
+            return "Slave Protocol Mismatch";
         default:
             return "Unknown";
     }
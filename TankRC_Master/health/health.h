@@ -11,12 +11,21 @@ enum class HealthCode {
     WifiDisconnected,
     LowBattery,
     SensorFailure,
+    RcLinkDegraded,
+    EventOverflow,
+    SlaveLinkLost,
+    SlaveLinkDegraded,
+    SlaveProtocolMismatch,
 };
 
 struct HealthStatus {
     HealthCode code = HealthCode::Ok;
     const char* message = "All systems nominal";
     std::uint32_t lastChangeMs = 0;
+    std::uint8_t rcLinkQuality = 0;  // rolling % of input polls with a fresh steering/throttle sample
+    std::uint32_t criticalEventsDropped = 0;
+    std::uint32_t eventsDropped = 0;     // normal lane
+    std::uint32_t eventsCoalesced = 0;
 };
 
 void setStatus(HealthCode code, const char* message, std::uint32_t timestampMs);
@@ -24,6 +33,9 @@ inline void setStatus(HealthCode code, const char* message) {
     setStatus(code, message, 0);
 }
 
+void setRcLinkQuality(std::uint8_t percent);
+void setEventBackpressure(std::uint32_t criticalDropped, std::uint32_t dropped, std::uint32_t coalesced);
+
 const HealthStatus& getStatus();
 const char* toString(HealthCode code);
 }  // namespace TankRC::Health
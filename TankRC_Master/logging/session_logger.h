@@ -10,11 +10,20 @@
 namespace TankRC::Logging {
 struct LogEntry {
     std::uint32_t epoch = 0;
+    std::uint32_t timeMs = 0;  // master millis(); slave times below use the same base
     float throttle = 0.0F;
     float steering = 0.0F;
     bool hazard = false;
     Comms::RcStatusMode mode = Comms::RcStatusMode::Active;
     float battery = 0.0F;
+    // Latest slave telemetry at log time, sampled by the slave at slaveSampleMs.
+    std::uint32_t slaveSampleMs = 0;
+    float leftTarget = 0.0F;
+    float leftOutput = 0.0F;
+    float rightTarget = 0.0F;
+    float rightOutput = 0.0F;
+    std::uint32_t slaveUptimeMs = 0;
+    std::uint32_t slaveI2cErrors = 0;
 };
 
 class SessionLogger {
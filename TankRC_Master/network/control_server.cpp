@@ -10,9 +10,16 @@
 #include <iterator>
 #include <vector>
 
+#include "../profiler/profiler.h"
 #include "config/pin_schema.h"
+#include "diagnostics/journal.h"
+#include "diagnostics/latency_trace.h"
+#include "diagnostics/link_stats.h"
+#include "diagnostics/slave_telemetry.h"
 namespace TankRC::Network {
 namespace {
+// The control task applies a calibration finish on its next 5 ms input poll.
+constexpr std::uint32_t kCalibrationFinishTimeoutMs = 100;
 
 class JsonStream {
   public:
@@ -416,6 +423,8 @@ header.hero {
     box-shadow:0 15px 30px rgba(0,0,0,0.5);
 }
 .toast.show { display:flex; }
+.histogram { display:grid; grid-template-columns:auto 1fr auto; gap:0.3rem 0.6rem; align-items:center; font-size:0.85rem; }
+.histogram__bar { height:0.7rem; border-radius:4px; background:var(--accent); min-width:1px; }
 @media (max-width:600px) {
     header.hero { flex-direction:column; align-items:flex-start; }
     .panel { margin:0.8rem; }
@@ -443,6 +452,43 @@ header.hero {
         </header>
         <div class="feature-grid" id="featureGrid"></div>
     </section>
+    <section class="panel">
+        <header>
+            <div>
+                <h2>RC calibration</h2>
+                <p style="margin:0;">Start, sweep every stick and switch to both ends, center the sticks, then finish.</p>
+            </div>
+            <div class="status-pill" id="calStatus">Idle</div>
+        </header>
+        <div class="feature-card__actions">
+            <button type="button" class="enable" data-cal="start">Start</button>
+            <button type="button" class="disable" data-cal="center">Mark center</button>
+            <button type="button" class="enable" data-cal="finish">Finish</button>
+            <button type="button" class="disable" data-cal="cancel">Cancel</button>
+        </div>
+    </section>
+    <section class="panel">
+        <header>
+            <div>
+                <h2>Slave link</h2>
+                <p style="margin:0;" id="linkSummary">Waiting for ping results.</p>
+                <p style="margin:0;" id="linkProtocol">Waiting for hello reply.</p>
+            </div>
+            <div class="status-pill" id="linkStatus">Offline</div>
+        </header>
+        <div class="histogram" id="rttHistogram"></div>
+    </section>
+    <section class="panel">
+        <header>
+            <div>
+                <h2>Incident journal</h2>
+                <p style="margin:0;">The last few seconds of RC frames, drive commands and events. Replay it on a PC with tools/journal_replay.</p>
+            </div>
+        </header>
+        <div class="feature-card__actions">
+            <button type="button" class="enable" onclick="location.href='/api/journal'">Download</button>
+        </div>
+    </section>
 </main>
 <div class="toast" id="toast"></div>
 <script>
@@ -534,10 +580,49 @@ async function refreshConfig() {
 async function refreshStatus() {
     const state = await fetchJson('/api/status');
     const labels = [];
-    labels.push(`RC ${state.rcLink ? 'online' : 'offline'}`);
+    labels.push(`RC ${state.rcLink ? 'online' : 'offline'} (${state.rcQuality}%, ${state.rcFailsafe})`);
     labels.push(`Wi-Fi ${state.wifiLink ? 'online' : 'offline'}`);
     labels.push(state.mode);
     statusBadge.textContent = labels.join(' • ');
+    document.getElementById('calStatus').textContent = state.rcCalibrating ? 'Capturing' : 'Idle';
+    renderLinkQuality(state.slaveLink.quality, state.slaveLink.protocol);
+}
+
+function renderLinkQuality(quality, protocol) {
+    const mismatch = !protocol.compatible && (protocol.replied || protocol.result !== 'ok');
+    document.getElementById('linkStatus').textContent =
+        mismatch ? 'Mismatch' : !quality.online ? 'Offline' : quality.degraded ? 'Degraded' : 'OK';
+    document.getElementById('linkProtocol').textContent = protocol.replied
+        ? `Protocol v${protocol.version}, slave v${protocol.slaveVersion} (min v${protocol.slaveMinVersion}): ${protocol.result}, encodings ${protocol.encodings}, features ${protocol.slaveFeatures}`
+        : `Protocol v${protocol.version}: waiting for hello reply (${protocol.hellos} sent)${protocol.result !== 'ok' ? `, ${protocol.result}` : ''}`;
+    document.getElementById('linkSummary').textContent =
+        `RTT ${quality.rttUs} µs (min ${quality.minRttUs}, max ${quality.maxRttUs}), jitter ${quality.jitterUs} µs, loss ${quality.lossPercent}% (${quality.lost}/${quality.sent} pings)`;
+    const peak = Math.max(1, ...quality.rttHistogram);
+    const grid = document.getElementById('rttHistogram');
+    grid.innerHTML = '';
+    quality.rttHistogram.forEach((count, i) => {
+        const bound = quality.rttBoundsUs[Math.min(i, quality.rttBoundsUs.length - 1)];
+        const label = document.createElement('span');
+        label.textContent = i < quality.rttBoundsUs.length ? `≤ ${bound} µs` : `> ${bound} µs`;
+        const bar = document.createElement('div');
+        bar.className = 'histogram__bar';
+        bar.style.width = `${(count * 100) / peak}%`;
+        const value = document.createElement('span');
+        value.textContent = count;
+        grid.append(label, bar, value);
+    });
+}
+
+async function postCalibration(action) {
+    const resp = await fetch('/api/rc/calibrate', {
+        method: 'POST',
+        body: new URLSearchParams({ action }),
+    });
+    if (!resp.ok) {
+        throw new Error(`Calibration ${action} failed`);
+    }
+    showToast(`Calibration: ${action}`);
+    return refreshStatus();
 }
 
 async function postConfig(payload) {
@@ -553,6 +638,9 @@ async function postConfig(payload) {
 }
 
 document.addEventListener('DOMContentLoaded', () => {
+    document.querySelectorAll('button[data-cal]').forEach(btn => {
+        btn.addEventListener('click', () => postCalibration(btn.dataset.cal).catch(err => showToast(err.message, 'danger')));
+    });
     Promise.all([refreshConfig(), refreshStatus()])
         .catch(err => showToast(err.message, 'danger'));
     setInterval(() => {
@@ -671,27 +759,34 @@ void ControlServer::begin(WifiManager* wifi,
                           Config::RuntimeConfig* config,
                           Storage::ConfigStore* store,
                           ApplyConfigCallback applyCallback,
-                          Logging::SessionLogger* logger) {
+                          Logging::SessionLogger* logger,
+                          Comms::RadioLink* radio) {
     wifi_ = wifi;
     config_ = config;
     store_ = store;
     applyCallback_ = applyCallback;
     logger_ = logger;
+    radio_ = radio;
 
     server_.on("/", HTTP_GET, [this]() { handleRoot(); });
     server_.on("/api/status", HTTP_GET, [this]() { handleStatus(); });
+    server_.on("/api/perf", HTTP_GET, [this]() { handlePerf(); });
+    server_.on("/api/journal", HTTP_GET, [this]() { handleJournal(); });
     server_.on("/api/config", HTTP_GET, [this]() { handleConfigGet(); });
     server_.on("/api/config", HTTP_POST, [this]() { handleConfigPost(); });
     server_.on("/api/control", HTTP_POST, [this]() { handleControlPost(); });
+    server_.on("/api/rc/calibrate", HTTP_POST, [this]() { handleRcCalibratePost(); });
     server_.on("/api/config/export", HTTP_GET, [this]() { handleConfigExport(); });
     server_.on("/api/config/import", HTTP_POST, [this]() { handleConfigImport(); });
     server_.on("/api/logs", HTTP_GET, [this]() {
         if (server_.hasArg("format") && server_.arg("format") == "csv") {
             auto entries = logger_ ? logger_->entries() : std::vector<Logging::LogEntry>{};
-            String csv = "epoch,steering,throttle,hazard,mode,battery\n";
+            String csv = "epoch,timeMs,steering,throttle,hazard,mode,battery,slaveSampleMs,leftTarget,leftOutput,rightTarget,rightOutput,slaveUptimeMs,slaveI2cErrors\n";
             for (const auto& e : entries) {
-                csv += String(e.epoch) + "," + String(e.steering, 3) + "," + String(e.throttle, 3) + "," +
-                       String(e.hazard ? 1 : 0) + "," + String(static_cast<int>(e.mode)) + "," + String(e.battery, 2) + "\n";
+                csv += String(e.epoch) + "," + String(e.timeMs) + "," + String(e.steering, 3) + "," + String(e.throttle, 3) + "," +
+                       String(e.hazard ? 1 : 0) + "," + String(static_cast<int>(e.mode)) + "," + String(e.battery, 2) + "," +
+                       String(e.slaveSampleMs) + "," + String(e.leftTarget, 3) + "," + String(e.leftOutput, 3) + "," + String(e.rightTarget, 3) + "," +
+                       String(e.rightOutput, 3) + "," + String(e.slaveUptimeMs) + "," + String(e.slaveI2cErrors) + "\n";
             }
             server_.send(200, "text/csv", csv);
         } else {
@@ -699,9 +794,13 @@ void ControlServer::begin(WifiManager* wifi,
             String json = "[";
             for (std::size_t i = 0; i < entries.size(); ++i) {
                 const auto& e = entries[i];
-                json += "{\"epoch\":" + String(e.epoch) + ",\"steering\":" + String(e.steering, 3) + ",\"throttle\":" + String(e.throttle, 3) +
+                json += "{\"epoch\":" + String(e.epoch) + ",\"timeMs\":" + String(e.timeMs) + ",\"steering\":" + String(e.steering, 3) + ",\"throttle\":" + String(e.throttle, 3) +
                         ",\"hazard\":" + String(e.hazard ? 1 : 0) + ",\"mode\":" + String(static_cast<int>(e.mode)) +
-                        ",\"battery\":" + String(e.battery, 2) + "}";
+                        ",\"battery\":" + String(e.battery, 2) + ",\"slaveSampleMs\":" + String(e.slaveSampleMs) +
+                        ",\"leftTarget\":" + String(e.leftTarget, 3) +
+                        ",\"leftOutput\":" + String(e.leftOutput, 3) + ",\"rightTarget\":" + String(e.rightTarget, 3) +
+                        ",\"rightOutput\":" + String(e.rightOutput, 3) + ",\"slaveUptimeMs\":" + String(e.slaveUptimeMs) +
+                        ",\"slaveI2cErrors\":" + String(e.slaveI2cErrors) + "}";
                 if (i + 1 < entries.size()) {
                     json += ",";
                 }
@@ -714,19 +813,21 @@ void ControlServer::begin(WifiManager* wifi,
 }
 
 void ControlServer::loop() {
+    static const Profiler::SectionId profile = Profiler::registerSection("http");
+    Profiler::Scope scope(profile);
     server_.handleClient();
 }
 
 void ControlServer::updateState(const ControlState& state) {
-    state_ = state;
+    state_.write(state);
 }
 
 Overrides ControlServer::getOverrides() const {
-    return overrides_;
+    return overrides_.read();
 }
 
 void ControlServer::clearOverrides() {
-    overrides_ = {};
+    overrides_.write({});
 }
 
 void ControlServer::notifyConfigApplied() {
@@ -742,6 +843,22 @@ void ControlServer::handleStatus() {
     sendJson(buildStatusJson());
 }
 
+void ControlServer::handlePerf() {
+    sendJson(buildPerfJson());
+}
+
+void ControlServer::handleJournal() {
+    std::vector<std::uint8_t> journal;
+    if (!Diagnostics::Journal::exportTo(journal, static_cast<std::uint8_t>(Drivers::RcInput::kChannelCount))) {
+        server_.send(503, "application/json", "{\"error\":\"journal busy\"}");
+        return;
+    }
+    server_.sendHeader("Content-Disposition", "attachment; filename=\"tankrc.journal\"");
+    server_.setContentLength(journal.size());
+    server_.send(200, "application/octet-stream", "");
+    server_.sendContent(reinterpret_cast<const char*>(journal.data()), journal.size());
+}
+
 void ControlServer::handleConfigGet() {
     sendJson(buildConfigJson());
 }
@@ -1048,6 +1165,94 @@ void ControlServer::handleConfigImport() {
                 return true;
             });
         }
+        if (key == "rcFailsafe") {
+            return parser.parseObject([&](const String& fsKey) {
+                int value = 0;
+                if (fsKey == "holdMs" || fsKey == "decelerateMs" || fsKey == "staleMs" || fsKey == "degradedQuality") {
+                    if (!parser.parseInt(value)) return false;
+                    if (value < 0 || value > 5000) return true;
+                    auto& fs = config_->rc.failsafe;
+                    if (fsKey == "holdMs") fs.holdMs = static_cast<std::uint16_t>(value);
+                    else if (fsKey == "decelerateMs") fs.decelerateMs = static_cast<std::uint16_t>(value);
+                    else if (fsKey == "staleMs") fs.staleMs = static_cast<std::uint16_t>(value);
+                    else fs.degradedQuality = static_cast<std::uint8_t>(std::min(value, 100));
+                    changed = true;
+                    return true;
+                }
+                return parser.skipValue();
+            });
+        }
+        if (key == "slaveLink") {
+            return parser.parseObject([&](const String& linkKey) {
+                int value = 0;
+                auto& link = config_->slaveLink;
+                std::uint16_t* target = nullptr;
+                int minValue = 0;
+                int maxValue = 0;
+                if (linkKey == "commandRateHz") {
+                    target = &link.commandRateHz;
+                    minValue = 50;
+                    maxValue = 1000;
+                } else if (linkKey == "heartbeatMs") {
+                    target = &link.heartbeatMs;
+                    minValue = 20;
+                    maxValue = 250;
+                } else if (linkKey == "throttleEpsilonPermille") {
+                    target = &link.throttleEpsilonPermille;
+                    maxValue = 100;
+                } else if (linkKey == "turnEpsilonPermille") {
+                    target = &link.turnEpsilonPermille;
+                    maxValue = 100;
+                } else if (linkKey == "telemetryPeriodMs") {
+                    return parser.parseArray([&](size_t index) {
+                        if (index >= std::size(link.telemetryPeriodMs)) {
+                            return parser.skipValue();
+                        }
+                        if (!parser.parseInt(value)) return false;
+                        if (value != 0 && (value < 20 || value > 60000)) return true;
+                        link.telemetryPeriodMs[index] = static_cast<std::uint16_t>(value);
+                        changed = true;
+                        return true;
+                    });
+                } else {
+                    return parser.skipValue();
+                }
+                if (!parser.parseInt(value)) return false;
+                if (value < minValue || value > maxValue) return true;
+                *target = static_cast<std::uint16_t>(value);
+                changed = true;
+                return true;
+            });
+        }
+        if (key == "rcCalibration") {
+            return parser.parseArray([&](size_t index) {
+                if (index >= std::size(config_->rc.calibration)) {
+                    return parser.skipValue();
+                }
+                auto& cal = config_->rc.calibration[index];
+                return parser.parseObject([&](const String& calKey) {
+                    int value = 0;
+                    if (calKey == "min" || calKey == "center" || calKey == "max" || calKey == "deadband") {
+                        if (!parser.parseInt(value)) return false;
+                        if (value < 0 || value > 2500) return true;
+                        const auto us = static_cast<std::uint16_t>(value);
+                        if (calKey == "min") cal.minUs = us;
+                        else if (calKey == "center") cal.centerUs = us;
+                        else if (calKey == "max") cal.maxUs = us;
+                        else cal.deadbandUs = us;
+                        changed = true;
+                        return true;
+                    }
+                    if (calKey == "reversed") {
+                        if (!parser.parseInt(value)) return false;
+                        cal.reversed = value != 0;
+                        changed = true;
+                        return true;
+                    }
+                    return parser.skipValue();
+                });
+            });
+        }
         if (key == "ntp") {
             return parser.parseObject([&](const String& ntpKey) {
                 if (ntpKey == "server") {
@@ -1267,6 +1472,54 @@ void ControlServer::handleConfigPost() {
         arg += (i + 1);
         assignPinArg(arg.c_str(), config_->rc.channelPins[i], false);
     }
+    auto assignFailsafeArg = [&](const char* name, std::uint16_t& target, int maxValue) {
+        int value = 0;
+        if (!server_.hasArg(name) || !parseIntStrict(server_.arg(name), value)) {
+            return;
+        }
+        if (value >= 0 && value <= maxValue && value != target) {
+            target = static_cast<std::uint16_t>(value);
+            changed = true;
+        }
+    };
+    assignFailsafeArg("rcHoldMs", config_->rc.failsafe.holdMs, 2000);
+    assignFailsafeArg("rcDecelerateMs", config_->rc.failsafe.decelerateMs, 5000);
+    assignFailsafeArg("rcStaleMs", config_->rc.failsafe.staleMs, 500);
+    {
+        int value = 0;
+        if (server_.hasArg("slaveCommandHz") && parseIntStrict(server_.arg("slaveCommandHz"), value) && value >= 50 &&
+            value <= 1000 && value != config_->slaveLink.commandRateHz) {
+            config_->slaveLink.commandRateHz = static_cast<std::uint16_t>(value);
+            changed = true;
+        }
+    }
+    for (size_t i = 0; i < std::size(config_->rc.calibration); ++i) {
+        auto& cal = config_->rc.calibration[i];
+        const String prefix = "rc" + String(static_cast<unsigned>(i + 1)) + "_";
+        auto assignUs = [&](const char* suffix, std::uint16_t& target) {
+            const String name = prefix + suffix;
+            int value = 0;
+            if (!server_.hasArg(name.c_str()) || !parseIntStrict(server_.arg(name.c_str()), value)) {
+                return;
+            }
+            if (value >= 0 && value <= 2500 && value != target) {
+                target = static_cast<std::uint16_t>(value);
+                changed = true;
+            }
+        };
+        assignUs("min", cal.minUs);
+        assignUs("center", cal.centerUs);
+        assignUs("max", cal.maxUs);
+        assignUs("deadband", cal.deadbandUs);
+        const String reverseArg = prefix + "reverse";
+        if (server_.hasArg(reverseArg.c_str())) {
+            const bool val = server_.arg(reverseArg.c_str()) == "1";
+            if (cal.reversed != val) {
+                cal.reversed = val;
+                changed = true;
+            }
+        }
+    }
 
     if (changed) {
         if (store_) {
@@ -1282,49 +1535,217 @@ void ControlServer::handleConfigPost() {
 
 void ControlServer::handleControlPost() {
     if (server_.hasArg("clear")) {
-        overrides_ = {};
+        overrides_.write({});
         sendJson("{\"ok\":true}");
         return;
     }
+    Overrides overrides = overrides_.read();
     if (server_.hasArg("hazardOverride")) {
-        overrides_.hazardOverride = server_.arg("hazardOverride") == "1";
-        if (overrides_.hazardOverride && server_.hasArg("hazard")) {
-            overrides_.hazardEnabled = server_.arg("hazard") == "1";
+        overrides.hazardOverride = server_.arg("hazardOverride") == "1";
+        if (overrides.hazardOverride && server_.hasArg("hazard")) {
+            overrides.hazardEnabled = server_.arg("hazard") == "1";
         }
     }
     if (server_.hasArg("lightsOverride")) {
-        overrides_.lightsOverride = server_.arg("lightsOverride") == "1";
-        if (overrides_.lightsOverride && server_.hasArg("lights")) {
-            overrides_.lightsEnabled = server_.arg("lights") == "1";
+        overrides.lightsOverride = server_.arg("lightsOverride") == "1";
+        if (overrides.lightsOverride && server_.hasArg("lights")) {
+            overrides.lightsEnabled = server_.arg("lights") == "1";
         }
     }
+    overrides_.write(overrides);
+    sendJson("{\"ok\":true}");
+}
+
+void ControlServer::handleRcCalibratePost() {
+    if (!radio_ || !server_.hasArg("action")) {
+        server_.send(400, "application/json", "{\"error\":\"missing action\"}");
+        return;
+    }
+    const String action = server_.arg("action");
+    if (action == "start") {
+        radio_->requestCalibration(Comms::RadioLink::CalibrationStep::Start);
+    } else if (action == "center") {
+        radio_->requestCalibration(Comms::RadioLink::CalibrationStep::Center);
+    } else if (action == "cancel") {
+        radio_->requestCalibration(Comms::RadioLink::CalibrationStep::Cancel);
+    } else if (action == "finish") {
+        std::size_t updated = 0;
+        if (!radio_->calibrating() || !radio_->finishCalibration(*config_, updated, kCalibrationFinishTimeoutMs)) {
+            server_.send(409, "application/json", "{\"error\":\"not calibrating\"}");
+            return;
+        }
+        if (store_) {
+            store_->save(*config_);
+        }
+        if (applyCallback_) {
+            applyCallback_();
+        }
+        sendJson("{\"ok\":true,\"channels\":" + String(static_cast<unsigned>(updated)) + "}");
+        return;
+    } else {
+        server_.send(400, "application/json", "{\"error\":\"unknown action\"}");
+        return;
+    }
     sendJson("{\"ok\":true}");
 }
 
 String ControlServer::buildStatusJson() const {
+    const ControlState state = state_.read();
+    const Overrides overrides = overrides_.read();
     String json = "{";
-    json += "\"steering\":" + String(state_.steering, 3) + ',';
-    json += "\"throttle\":" + String(state_.throttle, 3) + ',';
-    json += "\"hazard\":" + String(state_.hazard ? 1 : 0) + ',';
-    json += "\"lighting\":" + String(state_.lighting ? 1 : 0) + ',';
-    json += "\"mode\":\"" + modeToString(state_.mode) + "\",";
-    json += "\"modeClass\":\"" + modeClass(state_.mode) + "\",";
-    json += "\"rcLink\":" + String(state_.rcLinked ? 1 : 0) + ',';
-    json += "\"wifiLink\":" + String(state_.wifiLinked ? 1 : 0) + ',';
-    json += "\"ultraLeft\":" + String(state_.ultrasonicLeft, 3) + ',';
-    json += "\"ultraRight\":" + String(state_.ultrasonicRight, 3) + ',';
+    json += "\"steering\":" + String(state.steering, 3) + ',';
+    json += "\"throttle\":" + String(state.throttle, 3) + ',';
+    json += "\"hazard\":" + String(state.hazard ? 1 : 0) + ',';
+    json += "\"lighting\":" + String(state.lighting ? 1 : 0) + ',';
+    json += "\"mode\":\"" + modeToString(state.mode) + "\",";
+    json += "\"modeClass\":\"" + modeClass(state.mode) + "\",";
+    json += "\"rcLink\":" + String(state.rcLinked ? 1 : 0) + ',';
+    json += "\"rcQuality\":" + String(state.rcQuality) + ',';
+    json += "\"rcFailsafe\":\"" + String(Channels::toString(state.rcFailsafe)) + "\",";
+    json += "\"wifiLink\":" + String(state.wifiLinked ? 1 : 0) + ',';
+    json += "\"ultraLeft\":" + String(state.ultrasonicLeft, 3) + ',';
+    json += "\"ultraRight\":" + String(state.ultrasonicRight, 3) + ',';
     json += "\"ip\":\"" + escapeJson(wifi_ ? wifi_->ipAddress() : String("")) + "\",";
     json += "\"ap\":\"" + escapeJson(wifi_ ? wifi_->apAddress() : String("")) + "\",";
-    json += "\"overrideHazard\":" + String(overrides_.hazardOverride ? 1 : 0) + ',';
-    json += "\"overrideLights\":" + String(overrides_.lightsOverride ? 1 : 0) + ",";
+    json += "\"overrideHazard\":" + String(overrides.hazardOverride ? 1 : 0) + ',';
+    json += "\"overrideLights\":" + String(overrides.lightsOverride ? 1 : 0) + ",";
+    json += "\"rcCalibrating\":" + String(radio_ && radio_->calibrating() ? 1 : 0) + ",";
     const auto& health = Health::getStatus();
-    json += "\"health\":{\"code\":" + String(static_cast<int>(health.code)) + ",\"message\":\"" + escapeJson(String(health.message)) + "\",\"ts\":" + String(health.lastChangeMs) + "},";
+    json += "\"health\":{\"code\":" + String(static_cast<int>(health.code)) + ",\"message\":\"" + escapeJson(String(health.message)) + "\",\"ts\":" + String(health.lastChangeMs) + ",\"rcQuality\":" + String(health.rcLinkQuality) +
+            ",\"eventsCriticalDropped\":" + String(health.criticalEventsDropped) + ",\"eventsDropped\":" + String(health.eventsDropped) +
+            ",\"eventsCoalesced\":" + String(health.eventsCoalesced) + "},";
+    json += "\"latency\":{";
+    for (std::size_t i = 0; i < Diagnostics::kLatencyStageCount; ++i) {
+        const auto stage = static_cast<Diagnostics::LatencyStage>(i);
+        const auto histogram = Diagnostics::latencyHistogram(stage);
+        if (i > 0) {
+            json += ',';
+        }
+        json += "\"" + String(Diagnostics::toString(stage)) + "\":{";
+        json += "\"n\":" + String(histogram.count()) + ",";
+        json += "\"p50\":" + String(histogram.percentile(50)) + ",";
+        json += "\"p95\":" + String(histogram.percentile(95)) + ",";
+        json += "\"p99\":" + String(histogram.percentile(99)) + ",";
+        json += "\"max\":" + String(histogram.max()) + "}";
+    }
+    json += "},";
+    json += "\"slaveLink\":{";
+    for (std::size_t i = 0; i < Diagnostics::kLinkDirectionCount; ++i) {
+        const auto direction = static_cast<Diagnostics::LinkDirection>(i);
+        const auto counters = Diagnostics::linkCounters(direction);
+        if (i > 0) {
+            json += ',';
+        }
+        json += "\"" + String(Diagnostics::toString(direction)) + "\":{";
+        json += "\"frames\":" + String(counters.frames) + ",";
+        json += "\"crcErrors\":" + String(counters.crcErrors) + ",";
+        json += "\"gaps\":" + String(counters.gaps) + ",";
+        json += "\"duplicates\":" + String(counters.duplicates) + ",";
+        json += "\"resyncs\":" + String(counters.resyncs) + "}";
+    }
+    const auto sync = Diagnostics::configSync();
+    json += ",\"config\":{\"hash\":" + String(sync.hash) + ",\"slaveHash\":" + String(sync.slaveHash) +
+            ",\"pending\":" + String(sync.pending ? 1 : 0) + ",\"sends\":" + String(sync.sends) +
+            ",\"retries\":" + String(sync.retries) + ",\"nacks\":" + String(sync.nacks) +
+            ",\"resyncs\":" + String(sync.resyncs) + "}";
+    const auto traffic = Diagnostics::linkTraffic();
+    json += ",\"traffic\":{\"txBytesPerSec\":" + String(traffic.txBytesPerSec) +
+            ",\"commandBytesPerSec\":" + String(traffic.commandBytesPerSec) +
+            ",\"savedBytesPerSec\":" + String(traffic.savedBytesPerSec) +
+            ",\"commandsSent\":" + String(traffic.commandsSent) +
+            ",\"commandsSuppressed\":" + String(traffic.commandsSuppressed) + "}";
+    const auto quality = Diagnostics::linkQuality();
+    json += ",\"quality\":{\"online\":" + String(quality.online ? 1 : 0) + ",\"degraded\":" + String(quality.degraded ? 1 : 0) +
+            ",\"rttUs\":" + String(quality.rttUs) + ",\"minRttUs\":" + String(quality.minRttUs) +
+            ",\"maxRttUs\":" + String(quality.maxRttUs) + ",\"jitterUs\":" + String(quality.jitterUs) +
+            ",\"lossPercent\":" + String(quality.lossPercent) + ",\"sent\":" + String(quality.sent) +
+            ",\"answered\":" + String(quality.answered) + ",\"lost\":" + String(quality.lost) + ",\"rttBoundsUs\":[";
+    for (std::size_t i = 0; i < Diagnostics::kRttBoundsUs.size(); ++i) {
+        if (i > 0) {
+            json += ',';
+        }
+        json += String(Diagnostics::kRttBoundsUs[i]);
+    }
+    json += "],\"rttHistogram\":[";
+    for (std::size_t i = 0; i < Diagnostics::kRttBuckets; ++i) {
+        if (i > 0) {
+            json += ',';
+        }
+        json += String(quality.histogram[i]);
+    }
+    json += "]}";
+    const auto clock = Diagnostics::slaveClock();
+    json += ",\"clock\":{\"synced\":" + String(clock.synced ? 1 : 0) + ",\"offsetUs\":" + String(clock.offsetUs) +
+            ",\"driftPpm\":" + String(clock.driftPpm, 2) + ",\"residualUs\":" + String(clock.residualUs) +
+            ",\"rttUs\":" + String(clock.bestRttUs) + ",\"updates\":" + String(clock.updates) +
+            ",\"resyncs\":" + String(clock.resyncs) + "}";
+    const auto protocol = Diagnostics::linkProtocol();
+    json += ",\"protocol\":{\"pending\":" + String(protocol.pending ? 1 : 0) +
+            ",\"replied\":" + String(protocol.replied ? 1 : 0) + ",\"compatible\":" + String(protocol.compatible ? 1 : 0) +
+            ",\"result\":\"" + String(Comms::SlaveProtocol::toString(protocol.result)) + "\"" +
+            ",\"version\":" + String(protocol.version) + ",\"slaveVersion\":" + String(protocol.slaveVersion) +
+            ",\"slaveMinVersion\":" + String(protocol.slaveMinVersion) + ",\"encodings\":" + String(protocol.encodings) +
+            ",\"slaveFeatures\":" + String(protocol.slaveFeatures) + ",\"configBytes\":" + String(protocol.configBytes) +
+            ",\"slaveConfigBytes\":" + String(protocol.slaveConfigBytes) + ",\"hellos\":" + String(protocol.hellos) +
+            ",\"mismatches\":" + String(protocol.mismatches) + ",\"lengthErrors\":" + String(protocol.lengthErrors) + "}";
+    json += "},";
+    const auto telemetry = Diagnostics::slaveTelemetry();
+    auto pidJson = [](const Comms::SlaveProtocol::PidTerms& terms) {
+        return "{\"p\":" + String(terms.p, 4) + ",\"i\":" + String(terms.i, 4) + ",\"d\":" + String(terms.d, 4) + "}";
+    };
+    json += "\"slaveTelemetry\":{\"frames\":" + String(telemetry.frames) +
+            ",\"clockSynced\":" + String(telemetry.clockSynced ? 1 : 0) + ",\"ageMs\":{";
+    const auto nowMs = static_cast<std::uint32_t>(millis());
+    for (std::size_t i = 0; i < Comms::SlaveProtocol::kTelemetryGroupCount; ++i) {
+        if (i > 0) {
+            json += ',';
+        }
+        const std::uint32_t sampledMs = telemetry.sampledMs[i];
+        json += "\"" + String(Comms::SlaveProtocol::toString(static_cast<Comms::SlaveProtocol::TelemetryGroup>(i))) +
+                "\":" + (sampledMs == 0 ? String("null") : String(static_cast<std::int32_t>(nowMs - sampledMs)));
+    }
+    json += "},\"motors\":{\"leftTarget\":" + String(telemetry.motors.leftTarget, 3) +
+            ",\"leftOutput\":" + String(telemetry.motors.leftOutput, 3) +
+            ",\"rightTarget\":" + String(telemetry.motors.rightTarget, 3) +
+            ",\"rightOutput\":" + String(telemetry.motors.rightOutput, 3) + "}";
+    json += ",\"pid\":{\"left\":" + pidJson(telemetry.pid.left) + ",\"right\":" + pidJson(telemetry.pid.right) + "}";
+    json += ",\"loop\":{\"runs\":" + String(telemetry.loop.runs) + ",\"overruns\":" + String(telemetry.loop.overruns) +
+            ",\"missed\":" + String(telemetry.loop.missed) + ",\"lastExecUs\":" + String(telemetry.loop.lastExecUs) +
+            ",\"maxExecUs\":" + String(telemetry.loop.maxExecUs) + ",\"maxJitterUs\":" + String(telemetry.loop.maxJitterUs) + "}";
+    json += ",\"i2c\":{\"pcaErrors\":" + String(telemetry.i2c.pcaErrors) + ",\"pcfErrors\":" + String(telemetry.i2c.pcfErrors) +
+            ",\"pcaReady\":" + String(telemetry.i2c.pcaReady) + ",\"pcfReady\":" + String(telemetry.i2c.pcfReady) + "}";
+    json += ",\"system\":{\"uptimeMs\":" + String(telemetry.system.uptimeMs) + ",\"resetReason\":\"" +
+            String(Diagnostics::resetReasonName(telemetry.system.resetReason)) + "\"}},";
     json += "\"logCount\":" + String(logger_ ? logger_->size() : 0) + ",";
-    json += "\"serverTime\":" + String(state_.serverTime);
+    json += "\"serverTime\":" + String(state.serverTime);
     json += "}";
     return json;
 }
 
+String ControlServer::buildPerfJson() const {
+    auto sectionToJson = [&](const Profiler::Summary& s) {
+        return "{\"name\":\"" + escapeJson(String(s.name)) + "\",\"n\":" + String(s.count) + ",\"min\":" + String(s.minUs) +
+               ",\"avg\":" + String(s.avgUs, 1) + ",\"max\":" + String(s.maxUs) + ",\"p99\":" + String(s.p99Us) +
+               ",\"load\":" + String(s.loadPermille / 10.0F, 1) + "}";
+    };
+    String json = "{\"windowMs\":" + String(Profiler::kWindowMs) + ",\"master\":[";
+    for (std::size_t i = 0; i < Profiler::sectionCount(); ++i) {
+        if (i > 0) {
+            json += ',';
+        }
+        json += sectionToJson(Profiler::summary(static_cast<Profiler::SectionId>(i)));
+    }
+    json += "],\"slave\":[";
+    for (std::size_t i = 0; i < Profiler::remoteCount(); ++i) {
+        if (i > 0) {
+            json += ',';
+        }
+        json += sectionToJson(Profiler::remoteSummary(i));
+    }
+    json += "]}";
+    return json;
+}
+
 String ControlServer::buildConfigJson(bool includeSensitive) const {
     auto rgbToJson = [&](const Config::RgbChannel& rgb) {
         return "{\"r\":" + String(rgb.r) + ",\"g\":" + String(rgb.g) + ",\"b\":" + String(rgb.b) + "}";
@@ -1394,6 +1815,24 @@ String ControlServer::buildConfigJson(bool includeSensitive) const {
     }
     json += "],";
 
+    json += "\"rcFailsafe\":{";
+    json += "\"holdMs\":" + String(config_->rc.failsafe.holdMs) + ",";
+    json += "\"decelerateMs\":" + String(config_->rc.failsafe.decelerateMs) + ",";
+    json += "\"staleMs\":" + String(config_->rc.failsafe.staleMs) + ",";
+    json += "\"degradedQuality\":" + String(config_->rc.failsafe.degradedQuality);
+    json += "},";
+
+    json += "\"rcCalibration\":[";
+    for (std::size_t i = 0; i < std::size(config_->rc.calibration); ++i) {
+        const auto& cal = config_->rc.calibration[i];
+        json += "{\"min\":" + String(cal.minUs) + ",\"center\":" + String(cal.centerUs) + ",\"max\":" + String(cal.maxUs) +
+                ",\"deadband\":" + String(cal.deadbandUs) + ",\"reversed\":" + String(cal.reversed ? 1 : 0) + "}";
+        if (i + 1 < std::size(config_->rc.calibration)) {
+            json += ",";
+        }
+    }
+    json += "],";
+
     json += "\"ntp\":{";
     json += "\"server\":\"" + escapeJson(String(config_->ntp.server)) + "\",";
     json += "\"gmtOffsetSeconds\":" + String(config_->ntp.gmtOffsetSeconds) + ",";
@@ -1403,6 +1842,21 @@ String ControlServer::buildConfigJson(bool includeSensitive) const {
     json += "\"logging\":{";
     json += "\"enabled\":" + String(config_->logging.enabled ? 1 : 0) + ",";
     json += "\"maxEntries\":" + String(config_->logging.maxEntries);
+    json += "},";
+
+    json += "\"slaveLink\":{";
+    json += "\"commandRateHz\":" + String(config_->slaveLink.commandRateHz) + ",";
+    json += "\"heartbeatMs\":" + String(config_->slaveLink.heartbeatMs) + ",";
+    json += "\"throttleEpsilonPermille\":" + String(config_->slaveLink.throttleEpsilonPermille) + ",";
+    json += "\"turnEpsilonPermille\":" + String(config_->slaveLink.turnEpsilonPermille) + ",";
+    json += "\"telemetryPeriodMs\":[";
+    for (std::size_t i = 0; i < std::size(config_->slaveLink.telemetryPeriodMs); ++i) {
+        if (i > 0) {
+            json += ',';
+        }
+        json += String(config_->slaveLink.telemetryPeriodMs[i]);
+    }
+    json += "]";
     json += "}";
 
     json += "}";
@@ -4,6 +4,7 @@
 
 #include "comms/radio_link.h"
 #include "config/runtime_config.h"
+#include "core/snapshot.h"
 #include "health/health.h"
 #include "logging/session_logger.h"
 #include "network/wifi_manager.h"
@@ -17,6 +18,8 @@ struct ControlState {
     bool lighting = false;
     Comms::RcStatusMode mode = Comms::RcStatusMode::Active;
     bool rcLinked = true;
+    std::uint8_t rcQuality = 0;
+    Channels::FailsafeStage rcFailsafe = Channels::FailsafeStage::Linked;
     bool wifiLinked = true;
     float ultrasonicLeft = 1.0F;
     float ultrasonicRight = 1.0F;
@@ -38,8 +41,11 @@ class ControlServer {
                Config::RuntimeConfig* config,
                Storage::ConfigStore* store,
                ApplyConfigCallback applyCallback,
-               Logging::SessionLogger* logger);
+               Logging::SessionLogger* logger,
+               Comms::RadioLink* radio = nullptr);
     void loop();
+    // updateState() is called from the control task and getOverrides() is read there; the
+    // web handlers run on the network task. Both go through snapshots so neither side blocks.
     void updateState(const ControlState& state);
     Overrides getOverrides() const;
     void clearOverrides();
@@ -48,12 +54,16 @@ class ControlServer {
   private:
     void handleRoot();
     void handleStatus();
+    void handlePerf();
+    void handleJournal();
     void handleConfigGet();
     void handleConfigExport();
     void handleConfigImport();
     void handleConfigPost();
     void handleControlPost();
+    void handleRcCalibratePost();
     String buildStatusJson() const;
+    String buildPerfJson() const;
     String buildConfigJson(bool includeSensitive = false) const;
     String buildPinSchemaJson() const;
     void sendJson(const String& body);
@@ -63,8 +73,9 @@ class ControlServer {
     Storage::ConfigStore* store_ = nullptr;
     ApplyConfigCallback applyCallback_ = nullptr;
     Logging::SessionLogger* logger_ = nullptr;
+    Comms::RadioLink* radio_ = nullptr;
     WebServer server_{80};
-    ControlState state_{};
-    Overrides overrides_{};
+    Core::Snapshot<ControlState> state_{};
+    Core::Snapshot<Overrides> overrides_{};
 };
 }  // namespace TankRC::Network
@@ -14,15 +14,22 @@
 #endif
 #if TANKRC_BUILD_MASTER
 #include "core/system_init.cpp"
+#include "channels/rc_calibration.cpp"
 #include "comms/radio_link.cpp"
 #include "comms/slave_link.cpp"
 #include "config/runtime_config.cpp"
 #include "control/drive_controller.cpp"
+#include "diagnostics/journal.cpp"
+#include "diagnostics/latency_trace.cpp"
+#include "diagnostics/link_stats.cpp"
+#include "diagnostics/slave_telemetry.cpp"
 #include "drivers/rc_receiver.cpp"
 #include "features/sound_fx.cpp"
 #include "hal/hal.cpp"
 #include "health/health.cpp"
 #include "../events/event_bus.cpp"
+#include "../profiler/profiler.cpp"
+#include "../scheduler/scheduler.cpp"
 #if TANKRC_ENABLE_NETWORK
 #include "logging/session_logger.cpp"
 #include "network/control_server.cpp"
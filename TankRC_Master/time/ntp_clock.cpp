@@ -42,7 +42,7 @@ void NtpClock::update(bool wifiConnected) {
 }
 
 bool NtpClock::hasTime() const {
-    return synced_ && timeValid();
+    return synced_.load(std::memory_order_relaxed) && timeValid();
 }
 
 std::uint32_t NtpClock::now() const {
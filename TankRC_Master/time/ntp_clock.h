@@ -1,10 +1,14 @@
 #pragma once
 
+#include <atomic>
 #include <ctime>
 
 #include "config/runtime_config.h"
 
 namespace TankRC::Time {
+// configure() and update() belong to the network task. hasTime() and now() may be called
+// from any task: the sync state they read is an atomic only update() writes, and the time
+// itself comes from the C library clock the SNTP client sets.
 class NtpClock {
   public:
     void configure(const Config::RuntimeConfig& config);
@@ -17,7 +21,7 @@ class NtpClock {
 
     Config::NtpConfig config_{};
     bool requested_ = false;
-    bool synced_ = false;
+    std::atomic<bool> synced_{false};
     unsigned long lastRequestMs_ = 0UL;
 };
 }  // namespace TankRC::Time
@@ -1,12 +1,21 @@
 #include <Arduino.h>
 #include <array>
+#include <atomic>
 #include <algorithm>
 #include <cctype>
 #include <cstdarg>
+#include <cstdint>
 #include <cstring>
+#include <iterator>
 
+#include "../events/event_bus.h"
+#include "../profiler/profiler.h"
 #include "comms/radio_link.h"
 #include "control/drive_controller.h"
+#include "diagnostics/journal.h"
+#include "diagnostics/latency_trace.h"
+#include "diagnostics/link_stats.h"
+#include "diagnostics/slave_telemetry.h"
 #include "features/sound_fx.h"
 #include "config/runtime_config.h"
 #include "storage/config_store.h"
@@ -78,126 +87,180 @@ Context ctx_{};
 ApplyConfigCallback applyCallback_ = nullptr;
 String inputBuffer_;
 bool promptShown_ = false;
-bool wizardActive_ = false;
-bool wizardAbortRequested_ = false;
 ConsoleSource activeSource_ = ConsoleSource::Serial;
 ConsoleSource wizardSource_ = ConsoleSource::Serial;
 bool wizardInputPending_ = false;
 String wizardInputBuffer_;
 
+// The wizards are line-driven state machines: each input line advances one step and the
+// running tests are stepped from update(), so nothing here ever waits on the operator.
+enum class WizardMode : std::uint8_t { None, MainMenu, Features, TestMenu, MotorTest, SoundTest };
+WizardMode wizard_ = WizardMode::None;
+bool returnToMainMenu_ = false;
+std::size_t featureStep_ = 0;
+Config::FeatureConfig pendingFeatures_{};
+std::size_t testStep_ = 0;
+unsigned long testStepStartMs_ = 0;
+
+struct FeaturePrompt {
+    const char* label;
+    bool Config::FeatureConfig::*field;
+};
+
+constexpr FeaturePrompt kFeaturePrompts[] = {
+    {"Lights enabled", &Config::FeatureConfig::lightsEnabled},
+    {"Sound enabled", &Config::FeatureConfig::soundEnabled},
+    {"Sensors enabled", &Config::FeatureConfig::sensorsEnabled},
+    {"Wi-Fi enabled", &Config::FeatureConfig::wifiEnabled},
+    {"Ultrasonic sensors enabled", &Config::FeatureConfig::ultrasonicEnabled},
+    {"Tip-over protection enabled", &Config::FeatureConfig::tipOverEnabled},
+};
+constexpr std::size_t kFeaturePromptCount = std::size(kFeaturePrompts);
+
+struct DriveStep {
+    const char* label;
+    std::int8_t throttlePercent;
+    std::int8_t turnPercent;
+    unsigned long durationMs;
+};
+
+constexpr DriveStep kMotorTestSteps[] = {
+    {"Forward", 50, 0, 1500},
+    {"Reverse", -50, 0, 1500},
+    {"Pivot right", 0, 60, 1200},
+    {"Pivot left", 0, -60, 1200},
+};
+constexpr std::size_t kSoundTestPhases = 10;  // five on/off pulses
+constexpr unsigned long kSoundTestPhaseMs = 150;
+// 'cal done' waits this long for the control task to pick the finish up.
+constexpr std::uint32_t kCalibrationFinishTimeoutMs = 100;
+
+// The control task shares core 1 with the UI loop at a higher priority, so the override
+// is packed into one word it can read without ever waiting on a half-written value.
+constexpr std::uint32_t kOverrideDrive = 1U << 0;
+constexpr std::uint32_t kOverrideSound = 1U << 1;
+constexpr std::uint32_t kOverrideSoundOn = 1U << 2;
+std::atomic<std::uint32_t> testOverrideWord_{0};
+
+void publishDriveOverride(std::int8_t throttlePercent, std::int8_t turnPercent) {
+    testOverrideWord_ = kOverrideDrive | (static_cast<std::uint32_t>(static_cast<std::uint8_t>(throttlePercent)) << 8) |
+                        (static_cast<std::uint32_t>(static_cast<std::uint8_t>(turnPercent)) << 16);
+}
+
+void publishSoundOverride(bool on) {
+    testOverrideWord_ = kOverrideSound | (on ? kOverrideSoundOn : 0U);
+}
+
+void clearTestOverride() {
+    testOverrideWord_ = 0;
+}
+
+enum class Answer : std::uint8_t { Keep, Yes, No, Quit, Invalid };
+
+bool isQuit(const String& lower) {
+    return lower == "q" || lower == "quit" || lower == "exit";
+}
+
+Answer parseAnswer(String line) {
+    line.trim();
+    line.toLowerCase();
+    if (line.isEmpty()) {
+        return Answer::Keep;
+    }
+    if (isQuit(line)) {
+        return Answer::Quit;
+    }
+    if (line == "y" || line == "yes" || line == "1" || line == "true") {
+        return Answer::Yes;
+    }
+    if (line == "n" || line == "no" || line == "0" || line == "false") {
+        return Answer::No;
+    }
+    return Answer::Invalid;
+}
+
+void printIntPrompt(const char* label, int current) {
+    console.printf("%s [%d] : ", label, current);
+}
+
+void printBoolPrompt(const char* label, bool current) {
+    console.printf("%s [%s] : ", label, current ? "Y" : "N");
+}
+
 void processLine(const String& line, ConsoleSource source);
-void beginWizardSession();
-void finishWizardSession();
+void enterMainMenu();
+void enterTestMenu();
 
-void beginWizardSession() {
-    wizardActive_ = true;
+void beginWizardSession(WizardMode mode) {
+    wizard_ = mode;
     wizardSource_ = activeSource_;
     wizardInputPending_ = false;
     wizardInputBuffer_.clear();
-    wizardAbortRequested_ = false;
     inputBuffer_.clear();
 }
 
 void finishWizardSession() {
-    wizardActive_ = false;
+    clearTestOverride();
+    wizard_ = WizardMode::None;
     wizardInputPending_ = false;
-    wizardAbortRequested_ = false;
-}
-
-String readLineBlocking() {
-    const ConsoleSource source = wizardActive_ ? wizardSource_ : ConsoleSource::Serial;
-    String line;
-    while (true) {
-        if (source == ConsoleSource::Serial) {
-            while (Serial.available()) {
-                char c = static_cast<char>(Serial.read());
-                if (c == '\r') {
-                    continue;
-                }
-                if (c == '\n') {
-                    return line;
-                }
-                line += c;
-            }
-        } else {
-            if (wizardInputPending_) {
-                wizardInputPending_ = false;
-                String ready = wizardInputBuffer_;
-                wizardInputBuffer_.clear();
-                return ready;
-            }
-        }
-        delay(10);
-    }
+    returnToMainMenu_ = false;
 }
 
-int promptInt(const String& label, int current) {
-    console.print(label);
-    console.print(" [");
-    console.print(current);
-    console.print("] : ");
-    String line = readLineBlocking();
-    line.trim();
-    if (line.isEmpty()) {
-        return current;
-    }
-    String lower = line;
-    lower.toLowerCase();
-    if (lower == "q" || lower == "quit" || lower == "exit") {
-        wizardAbortRequested_ = true;
-        return current;
+// Leaves the current sub-wizard for the main menu when it was opened from there.
+void leaveSubWizard() {
+    if (returnToMainMenu_) {
+        enterMainMenu();
+    } else {
+        finishWizardSession();
     }
-    return line.toInt();
 }
 
-bool promptBool(const String& label, bool current) {
-    console.print(label);
-    console.print(" [");
-    console.print(current ? "Y" : "N");
-    console.print("] : ");
-
-    while (true) {
-        String line = readLineBlocking();
-        line.trim();
-        line.toLowerCase();
-        if (line.isEmpty()) {
-            return current;
-        }
-        if (line == "q" || line == "quit" || line == "exit") {
-            wizardAbortRequested_ = true;
-            return current;
-        }
-        if (line == "y" || line == "yes" || line == "1" || line == "true") {
-            return true;
-        }
-        if (line == "n" || line == "no" || line == "0" || line == "false") {
-            return false;
-        }
-        console.print(F("Please type y/n: "));
+void promptFeatureStep() {
+    if (featureStep_ < kFeaturePromptCount) {
+        const auto& prompt = kFeaturePrompts[featureStep_];
+        printBoolPrompt(prompt.label, pendingFeatures_.*(prompt.field));
+    } else {
+        printBoolPrompt("Apply these changes?", true);
     }
 }
 
 void runFeatureWizard() {
     if (!ctx_.config) {
         console.println(F("Config not initialized."));
+        leaveSubWizard();
         return;
     }
-
-    beginWizardSession();
-
-    Config::FeatureConfig features = ctx_.config->features;
+    if (wizard_ == WizardMode::None) {
+        beginWizardSession(WizardMode::Features);
+    }
+    wizard_ = WizardMode::Features;
+    pendingFeatures_ = ctx_.config->features;
+    featureStep_ = 0;
     console.println(F("Feature configuration. Press Enter to keep the current setting."));
+    promptFeatureStep();
+}
 
-    features.lightsEnabled = promptBool("Lights enabled", features.lightsEnabled);
-    features.soundEnabled = promptBool("Sound enabled", features.soundEnabled);
-    features.sensorsEnabled = promptBool("Sensors enabled", features.sensorsEnabled);
-    features.wifiEnabled = promptBool("Wi-Fi enabled", features.wifiEnabled);
-    features.ultrasonicEnabled = promptBool("Ultrasonic sensors enabled", features.ultrasonicEnabled);
-    features.tipOverEnabled = promptBool("Tip-over protection enabled", features.tipOverEnabled);
-
-    const bool apply = promptBool("Apply these changes?", true);
-    if (apply) {
-        ctx_.config->features = features;
+void handleFeatureLine(const String& line) {
+    const Answer answer = parseAnswer(line);
+    if (answer == Answer::Quit) {
+        console.println(F("Feature changes discarded."));
+        finishWizardSession();
+        return;
+    }
+    if (answer == Answer::Invalid) {
+        console.print(F("Please type y/n: "));
+        return;
+    }
+    if (featureStep_ < kFeaturePromptCount) {
+        if (answer != Answer::Keep) {
+            pendingFeatures_.*(kFeaturePrompts[featureStep_].field) = answer == Answer::Yes;
+        }
+        ++featureStep_;
+        promptFeatureStep();
+        return;
+    }
+    if (answer != Answer::No) {
+        ctx_.config->features = pendingFeatures_;
         if (applyCallback_) {
             applyCallback_();
         }
@@ -205,54 +268,82 @@ void runFeatureWizard() {
     } else {
         console.println(F("Feature changes discarded."));
     }
+    leaveSubWizard();
+}
 
-    finishWizardSession();
+void startMotorStep() {
+    const auto& step = kMotorTestSteps[testStep_];
+    console.println(step.label);
+    publishDriveOverride(step.throttlePercent, step.turnPercent);
+    testStepStartMs_ = millis();
 }
 
-void performDrivePulse(float throttle, float turn, unsigned long durationMs, const char* label) {
+void runMotorTest() {
     if (!ctx_.drive) {
         console.println(F("Drive controller unavailable."));
+        enterTestMenu();
         return;
     }
-
-    console.println(label);
-    Comms::DriveCommand cmd;
-    cmd.throttle = throttle;
-    cmd.turn = turn;
-    const unsigned long end = millis() + durationMs;
-    while (millis() < end) {
-        ctx_.drive->setCommand(cmd);
-        ctx_.drive->update();
-        delay(25);
-    }
-    cmd.throttle = 0.0F;
-    cmd.turn = 0.0F;
-    ctx_.drive->setCommand(cmd);
-    ctx_.drive->update();
-}
-
-void runMotorTest() {
-    console.println(F("Motor test starting. Tracks will spin forward/back and pivot."));
-    performDrivePulse(0.5F, 0.0F, 1500, "Forward");
-    performDrivePulse(-0.5F, 0.0F, 1500, "Reverse");
-    performDrivePulse(0.0F, 0.6F, 1200, "Pivot right");
-    performDrivePulse(0.0F, -0.6F, 1200, "Pivot left");
-    console.println(F("Motor test complete."));
+    console.println(F("Motor test starting. Tracks will spin forward/back and pivot. Type q to stop."));
+    wizard_ = WizardMode::MotorTest;
+    testStep_ = 0;
+    startMotorStep();
 }
 
 void runSoundTest() {
     if (!ctx_.sound) {
         console.println(F("Sound controller unavailable."));
+        enterTestMenu();
         return;
     }
     console.println(F("Pulsing sound output."));
-    for (int i = 0; i < 5; ++i) {
-        ctx_.sound->update(true);
-        delay(150);
-        ctx_.sound->update(false);
-        delay(150);
+    wizard_ = WizardMode::SoundTest;
+    testStep_ = 0;
+    testStepStartMs_ = millis();
+    publishSoundOverride(true);
+}
+
+void finishTest(const char* message) {
+    clearTestOverride();
+    console.println(message);
+    enterTestMenu();
+}
+
+// Advances a running motor/sound test; called from update() so the control task keeps
+// streaming the override at its own rate in between.
+void serviceTest() {
+    const unsigned long now = millis();
+    if (wizard_ == WizardMode::MotorTest) {
+        if (now - testStepStartMs_ < kMotorTestSteps[testStep_].durationMs) {
+            return;
+        }
+        if (++testStep_ >= std::size(kMotorTestSteps)) {
+            finishTest("Motor test complete.");
+            return;
+        }
+        startMotorStep();
+    } else if (wizard_ == WizardMode::SoundTest) {
+        if (now - testStepStartMs_ < kSoundTestPhaseMs) {
+            return;
+        }
+        if (++testStep_ >= kSoundTestPhases) {
+            finishTest("Sound test complete.");
+            return;
+        }
+        testStepStartMs_ = now;
+        publishSoundOverride((testStep_ % 2U) == 0U);
     }
-    console.println(F("Sound test complete."));
+}
+
+void handleTestRunningLine(const String& line) {
+    String lower = line;
+    lower.trim();
+    lower.toLowerCase();
+    if (isQuit(lower) || lower == "stop") {
+        finishTest("Test stopped.");
+        return;
+    }
+    console.println(F("Test running. Type q to stop."));
 }
 
 void runBatteryTest() {
@@ -266,41 +357,51 @@ void runBatteryTest() {
     console.println(F(" V"));
 }
 
+void enterTestMenu() {
+    wizard_ = WizardMode::TestMenu;
+    console.println();
+    console.println(F("=== Test Wizard ==="));
+    console.println(F("1) Tank drive sweep"));
+    console.println(F("2) Sound pulse"));
+    console.println(F("3) Battery voltage read"));
+    console.println(F("0) Exit test wizard"));
+    printIntPrompt("Select option", 0);
+}
+
 void runTestWizard() {
-    beginWizardSession();
+    if (wizard_ == WizardMode::None) {
+        beginWizardSession(WizardMode::TestMenu);
+    }
+    enterTestMenu();
+}
 
-    bool done = false;
-    while (!done) {
-        console.println();
-        console.println(F("=== Test Wizard ==="));
-        console.println(F("1) Tank drive sweep"));
-        console.println(F("2) Sound pulse"));
-        console.println(F("3) Battery voltage read"));
-        console.println(F("0) Exit test wizard"));
-        const int choice = promptInt("Select option", 0);
-        if (wizardAbortRequested_) {
+void handleTestMenuLine(String line) {
+    line.trim();
+    String lower = line;
+    lower.toLowerCase();
+    if (isQuit(lower)) {
+        finishWizardSession();
+        return;
+    }
+    switch (line.isEmpty() ? 0 : line.toInt()) {
+        case 1:
+            runMotorTest();
+            break;
+        case 2:
+            runSoundTest();
+            break;
+        case 3:
+            runBatteryTest();
+            enterTestMenu();
+            break;
+        case 0:
+            leaveSubWizard();
+            break;
+        default:
+            console.println(F("Unknown selection."));
+            enterTestMenu();
             break;
-        }
-        switch (choice) {
-            case 1:
-                runMotorTest();
-                break;
-            case 2:
-                runSoundTest();
-                break;
-            case 3:
-                runBatteryTest();
-                break;
-            case 0:
-                done = true;
-                break;
-            default:
-                console.println(F("Unknown selection."));
-                break;
-        }
     }
-
-    finishWizardSession();
 }
 
 bool saveConfigToStore() {
@@ -351,51 +452,434 @@ bool resetStoredConfig() {
     return true;
 }
 
+void printCalibration() {
+    if (!ctx_.config) {
+        console.println(F("Config unavailable."));
+        return;
+    }
+    console.println(F("CH   min  center  max  deadband  reversed"));
+    for (std::size_t i = 0; i < std::size(ctx_.config->rc.calibration); ++i) {
+        const auto& cal = ctx_.config->rc.calibration[i];
+        console.printf("%u  %5u  %5u  %5u  %5u     %s\n",
+                       static_cast<unsigned>(i + 1),
+                       cal.minUs,
+                       cal.centerUs,
+                       cal.maxUs,
+                       cal.deadbandUs,
+                       cal.reversed ? "yes" : "no");
+    }
+}
+
+bool parseCalibrationChannel(const String& text, std::size_t& index) {
+    const int channel = text.toInt();
+    if (!ctx_.config || channel < 1 || channel > static_cast<int>(std::size(ctx_.config->rc.calibration))) {
+        console.println(F("Channel must be 1-6."));
+        return false;
+    }
+    index = static_cast<std::size_t>(channel - 1);
+    return true;
+}
+
+void handleCalibrationCommand(String args) {
+    if (!ctx_.radio || !ctx_.config) {
+        console.println(F("RC link unavailable."));
+        return;
+    }
+    args.trim();
+    if (args.isEmpty() || args == "start") {
+        ctx_.radio->requestCalibration(Comms::RadioLink::CalibrationStep::Start);
+        console.println(F("RC calibration started. Move every stick and switch to both ends,"));
+        console.println(F("then center the sticks and type 'cal center', followed by 'cal done'."));
+        return;
+    }
+    if (args == "center") {
+        if (!ctx_.radio->calibrating()) {
+            console.println(F("No calibration running. Type 'cal' to start."));
+            return;
+        }
+        ctx_.radio->requestCalibration(Comms::RadioLink::CalibrationStep::Center);
+        console.println(F("Center captured."));
+        return;
+    }
+    if (args == "done" || args == "finish") {
+        if (!ctx_.radio->calibrating()) {
+            console.println(F("No calibration running. Type 'cal' to start."));
+            return;
+        }
+        std::size_t updated = 0;
+        if (!ctx_.radio->finishCalibration(*ctx_.config, updated, kCalibrationFinishTimeoutMs)) {
+            console.println(F("Control task did not respond; calibration still running."));
+            return;
+        }
+        if (applyCallback_) {
+            applyCallback_();
+        }
+        console.printf("Calibrated %u channel(s). Run 'save' to persist.\n", static_cast<unsigned>(updated));
+        printCalibration();
+        return;
+    }
+    if (args == "cancel") {
+        ctx_.radio->requestCalibration(Comms::RadioLink::CalibrationStep::Cancel);
+        console.println(F("Calibration cancelled."));
+        return;
+    }
+    if (args == "show") {
+        printCalibration();
+        return;
+    }
+    if (args.startsWith("reverse ")) {
+        std::size_t index = 0;
+        if (!parseCalibrationChannel(args.substring(8), index)) {
+            return;
+        }
+        auto& cal = ctx_.config->rc.calibration[index];
+        cal.reversed = !cal.reversed;
+        if (applyCallback_) {
+            applyCallback_();
+        }
+        console.printf("CH%u reversed: %s\n", static_cast<unsigned>(index + 1), cal.reversed ? "yes" : "no");
+        return;
+    }
+    if (args.startsWith("deadband ")) {
+        String rest = args.substring(9);
+        rest.trim();
+        const int space = rest.indexOf(' ');
+        std::size_t index = 0;
+        if (space < 0 || !parseCalibrationChannel(rest.substring(0, space), index)) {
+            console.println(F("Usage: cal deadband <ch> <us>"));
+            return;
+        }
+        const int value = rest.substring(space + 1).toInt();
+        auto& cal = ctx_.config->rc.calibration[index];
+        cal.deadbandUs = static_cast<std::uint16_t>(std::clamp(value, 0, 200));
+        if (applyCallback_) {
+            applyCallback_();
+        }
+        console.printf("CH%u deadband: %u us\n", static_cast<unsigned>(index + 1), cal.deadbandUs);
+        return;
+    }
+    console.println(F("Usage: cal [start|center|done|cancel|show|reverse <ch>|deadband <ch> <us>]"));
+}
+
+void printLatency() {
+    console.println(F("stage      count    p50    p95    p99    max  (us)"));
+    for (std::size_t i = 0; i < Diagnostics::kLatencyStageCount; ++i) {
+        const auto stage = static_cast<Diagnostics::LatencyStage>(i);
+        const auto histogram = Diagnostics::latencyHistogram(stage);
+        console.printf("%-9s %6lu %6lu %6lu %6lu %6lu\n",
+                       Diagnostics::toString(stage),
+                       static_cast<unsigned long>(histogram.count()),
+                       static_cast<unsigned long>(histogram.percentile(50)),
+                       static_cast<unsigned long>(histogram.percentile(95)),
+                       static_cast<unsigned long>(histogram.percentile(99)),
+                       static_cast<unsigned long>(histogram.max()));
+    }
+}
+
+void handleLatencyCommand(const String& args) {
+    if (args.isEmpty() || args == "show") {
+        printLatency();
+        return;
+    }
+    if (args == "reset") {
+        Diagnostics::resetLatency();
+        console.println(F("Latency histograms cleared."));
+        return;
+    }
+    console.println(F("Usage: lat [show|reset]"));
+}
+
+void printLinkStats() {
+    console.println(F("direction     frames  crc-err     gaps    dups  resyncs"));
+    for (std::size_t i = 0; i < Diagnostics::kLinkDirectionCount; ++i) {
+        const auto direction = static_cast<Diagnostics::LinkDirection>(i);
+        const auto counters = Diagnostics::linkCounters(direction);
+        console.printf("%-10s %9lu %8lu %8lu %7lu %8lu\n",
+                       Diagnostics::toString(direction),
+                       static_cast<unsigned long>(counters.frames),
+                       static_cast<unsigned long>(counters.crcErrors),
+                       static_cast<unsigned long>(counters.gaps),
+                       static_cast<unsigned long>(counters.duplicates),
+                       static_cast<unsigned long>(counters.resyncs));
+    }
+    const auto sync = Diagnostics::configSync();
+    console.printf("config %08lx, slave %08lx%s: %lu sends, %lu retries, %lu nacks, %lu resyncs\n",
+                   static_cast<unsigned long>(sync.hash),
+                   static_cast<unsigned long>(sync.slaveHash),
+                   sync.pending ? " (awaiting ack)" : "",
+                   static_cast<unsigned long>(sync.sends),
+                   static_cast<unsigned long>(sync.retries),
+                   static_cast<unsigned long>(sync.nacks),
+                   static_cast<unsigned long>(sync.resyncs));
+    const auto protocol = Diagnostics::linkProtocol();
+    if (protocol.replied) {
+        console.printf("protocol v%u, slave v%u (min v%u) %s: encodings %02x, features %04x, config %u/%u B, %lu hellos, %lu mismatches, %lu length errors\n",
+                       static_cast<unsigned>(protocol.version),
+                       static_cast<unsigned>(protocol.slaveVersion),
+                       static_cast<unsigned>(protocol.slaveMinVersion),
+                       Comms::SlaveProtocol::toString(protocol.result),
+                       static_cast<unsigned>(protocol.encodings),
+                       static_cast<unsigned>(protocol.slaveFeatures),
+                       static_cast<unsigned>(protocol.configBytes),
+                       static_cast<unsigned>(protocol.slaveConfigBytes),
+                       static_cast<unsigned long>(protocol.hellos),
+                       static_cast<unsigned long>(protocol.mismatches),
+                       static_cast<unsigned long>(protocol.lengthErrors));
+    } else {
+        console.printf("protocol v%u %s: waiting for hello reply (%lu sent)\n",
+                       static_cast<unsigned>(protocol.version),
+                       Comms::SlaveProtocol::toString(protocol.result),
+                       static_cast<unsigned long>(protocol.hellos));
+    }
+    const auto traffic = Diagnostics::linkTraffic();
+    console.printf("tx %lu B/s (commands %lu B/s, %lu B/s saved); %lu commands sent, %lu suppressed\n",
+                   static_cast<unsigned long>(traffic.txBytesPerSec),
+                   static_cast<unsigned long>(traffic.commandBytesPerSec),
+                   static_cast<unsigned long>(traffic.savedBytesPerSec),
+                   static_cast<unsigned long>(traffic.commandsSent),
+                   static_cast<unsigned long>(traffic.commandsSuppressed));
+    const auto quality = Diagnostics::linkQuality();
+    console.printf("ping %s: rtt %lu us (min %lu, max %lu), jitter %lu us, loss %u%% (%lu/%lu lost)\n",
+                   !quality.online ? "offline" : quality.degraded ? "DEGRADED" : "ok",
+                   static_cast<unsigned long>(quality.rttUs),
+                   static_cast<unsigned long>(quality.minRttUs),
+                   static_cast<unsigned long>(quality.maxRttUs),
+                   static_cast<unsigned long>(quality.jitterUs),
+                   static_cast<unsigned>(quality.lossPercent),
+                   static_cast<unsigned long>(quality.lost),
+                   static_cast<unsigned long>(quality.sent));
+    const auto clock = Diagnostics::slaveClock();
+    if (clock.synced) {
+        console.printf("clock offset %ld us, drift %+.2f ppm, residual %ld us (rtt %lu us), %lu updates, %lu resyncs\n",
+                       static_cast<long>(clock.offsetUs),
+                       clock.driftPpm,
+                       static_cast<long>(clock.residualUs),
+                       static_cast<unsigned long>(clock.bestRttUs),
+                       static_cast<unsigned long>(clock.updates),
+                       static_cast<unsigned long>(clock.resyncs));
+    } else {
+        console.println(F("clock not synced yet"));
+    }
+    std::uint32_t peak = 0;
+    for (const auto count : quality.histogram) {
+        peak = std::max(peak, count);
+    }
+    constexpr int kBarWidth = 40;
+    for (std::size_t i = 0; i < Diagnostics::kRttBuckets; ++i) {
+        const std::uint32_t count = quality.histogram[i];
+        const int bar = peak > 0 ? static_cast<int>((static_cast<std::uint64_t>(count) * kBarWidth + peak - 1) / peak) : 0;
+        if (i < Diagnostics::kRttBoundsUs.size()) {
+            console.printf("  <=%6lu us %8lu ", static_cast<unsigned long>(Diagnostics::kRttBoundsUs[i]), static_cast<unsigned long>(count));
+        } else {
+            console.printf("   >%6lu us %8lu ", static_cast<unsigned long>(Diagnostics::kRttBoundsUs.back()), static_cast<unsigned long>(count));
+        }
+        for (int j = 0; j < bar; ++j) {
+            console.print('#');
+        }
+        console.println();
+    }
+}
+
+void printSlaveTelemetry() {
+    const auto telemetry = Diagnostics::slaveTelemetry();
+    if (telemetry.frames == 0) {
+        console.println(F("No slave telemetry received yet."));
+        return;
+    }
+    const auto& motors = telemetry.motors;
+    console.printf("motors  L %+.3f -> %+.3f  R %+.3f -> %+.3f (target -> ramp output)\n",
+                   motors.leftTarget, motors.leftOutput, motors.rightTarget, motors.rightOutput);
+    const auto& pid = telemetry.pid;
+    console.printf("pid     L p%+.3f i%+.3f d%+.3f  R p%+.3f i%+.3f d%+.3f\n",
+                   pid.left.p, pid.left.i, pid.left.d, pid.right.p, pid.right.i, pid.right.d);
+    const auto& loop = telemetry.loop;
+    console.printf("loop    %lu runs, exec %lu/%lu us (last/max), jitter max %lu us, %lu overruns, %lu missed\n",
+                   static_cast<unsigned long>(loop.runs),
+                   static_cast<unsigned long>(loop.lastExecUs),
+                   static_cast<unsigned long>(loop.maxExecUs),
+                   static_cast<unsigned long>(loop.maxJitterUs),
+                   static_cast<unsigned long>(loop.overruns),
+                   static_cast<unsigned long>(loop.missed));
+    const auto& i2c = telemetry.i2c;
+    console.printf("i2c     PCA9685 %s, %lu errors  PCF8575 %s, %lu errors\n",
+                   i2c.pcaReady ? "ok" : "down",
+                   static_cast<unsigned long>(i2c.pcaErrors),
+                   i2c.pcfReady ? "ok" : "down",
+                   static_cast<unsigned long>(i2c.pcfErrors));
+    console.printf("system  up %lu s, last reset: %s\n",
+                   static_cast<unsigned long>(telemetry.system.uptimeMs / 1000UL),
+                   Diagnostics::resetReasonName(telemetry.system.resetReason));
+    console.print(telemetry.clockSynced ? F("age ms ") : F("age ms (arrival, clock not synced) "));
+    const auto now = static_cast<std::uint32_t>(millis());
+    for (std::size_t i = 0; i < Comms::SlaveProtocol::kTelemetryGroupCount; ++i) {
+        const auto group = static_cast<Comms::SlaveProtocol::TelemetryGroup>(i);
+        if (telemetry.sampledMs[i] == 0) {
+            console.printf(" %s -", Comms::SlaveProtocol::toString(group));
+        } else {
+            console.printf(" %s %ld", Comms::SlaveProtocol::toString(group),
+                           static_cast<long>(static_cast<std::int32_t>(now - telemetry.sampledMs[i])));
+        }
+    }
+    console.println();
+}
+
+void printEventStats() {
+    const Events::Stats stats = Events::stats();
+    console.println(F("lane       published  dropped  coalesced  high-water"));
+    for (std::size_t i = 0; i < Events::kPriorityCount; ++i) {
+        const auto& lane = stats.lanes[i];
+        console.printf("%-9s %10lu %8lu %10lu %11lu\n",
+                       Events::toString(static_cast<Events::Priority>(i)),
+                       static_cast<unsigned long>(lane.published),
+                       static_cast<unsigned long>(lane.dropped),
+                       static_cast<unsigned long>(lane.coalesced),
+                       static_cast<unsigned long>(lane.highWater));
+    }
+    console.printf("dispatched: %lu\n", static_cast<unsigned long>(stats.dispatched));
+}
+
+void handleEventsCommand(const String& args) {
+    if (args.isEmpty() || args == "show") {
+        printEventStats();
+        return;
+    }
+    if (args == "reset") {
+        Events::resetStats();
+        console.println(F("Event bus counters cleared."));
+        return;
+    }
+    console.println(F("Usage: events [show|reset]"));
+}
+
+void handleJournalCommand(const String& args) {
+    if (args.isEmpty() || args == "show") {
+        const auto stats = Diagnostics::Journal::stats();
+        console.printf("Journal: %lu records, %lu / %lu bytes, %lu evicted, %lu skipped during export\n",
+                       static_cast<unsigned long>(stats.records),
+                       static_cast<unsigned long>(stats.bytes),
+                       static_cast<unsigned long>(Diagnostics::Journal::kCapacityBytes),
+                       static_cast<unsigned long>(stats.evicted),
+                       static_cast<unsigned long>(stats.skipped));
+        console.println(F("Download it from /api/journal and replay with tools/journal_replay."));
+        return;
+    }
+    if (args == "clear") {
+        if (!Diagnostics::Journal::clear()) {
+            console.println(F("Journal busy: a download is in progress. Try again."));
+            return;
+        }
+        console.println(F("Journal cleared."));
+        return;
+    }
+    console.println(F("Usage: journal [show|clear]"));
+}
+
+void printProfileRow(const Profiler::Summary& s) {
+    console.printf("%-15s %6lu %6lu %7.1f %6lu %6lu %5.1f%%\n",
+                   s.name,
+                   static_cast<unsigned long>(s.count),
+                   static_cast<unsigned long>(s.minUs),
+                   static_cast<double>(s.avgUs),
+                   static_cast<unsigned long>(s.p99Us),
+                   static_cast<unsigned long>(s.maxUs),
+                   static_cast<double>(s.loadPermille) / 10.0);
+}
+
+void printTop() {
+    console.printf("section          runs    min     avg    p99    max   load  (us, last %lu ms)\n",
+                   static_cast<unsigned long>(Profiler::kWindowMs));
+    for (std::size_t i = 0; i < Profiler::sectionCount(); ++i) {
+        printProfileRow(Profiler::summary(static_cast<Profiler::SectionId>(i)));
+    }
+    if (Profiler::remoteCount() == 0) {
+        return;
+    }
+    console.println(F("-- slave --"));
+    for (std::size_t i = 0; i < Profiler::remoteCount(); ++i) {
+        printProfileRow(Profiler::remoteSummary(i));
+    }
+}
+
 void showHelp() {
     console.println();
     console.println(F("=== TankRC Console Shortcuts ==="));
     console.println(F("menu    : Open the feature/test dashboard"));
     console.println(F("features: Toggle lights, sound, Wifi, sensors"));
     console.println(F("tests   : Run motor/sound/battery diagnostics"));
+    console.println(F("cal     : Capture RC endpoints/center (cal help for options)"));
+    console.println(F("lat     : RC input -> motor PWM latency per stage (lat reset)"));
+    console.println(F("top     : CPU time per task/section on master and slave"));
+    console.println(F("link    : Slave UART errors, config sync, ping RTT/jitter/loss"));
+    console.println(F("telem   : Slave motors, PID terms, loop timing, I2C errors, uptime"));
+    console.println(F("events  : Event bus lane backpressure (events reset)"));
+    console.println(F("journal : Incident journal fill level (journal clear)"));
     console.println(F("save    : Persist current settings"));
     console.println(F("load    : Reload saved settings"));
     console.println(F("defaults: Restore factory defaults"));
     console.println(F("reset   : Clear saved flash storage"));
 }
 
+void enterMainMenu() {
+    wizard_ = WizardMode::MainMenu;
+    returnToMainMenu_ = false;
+    console.println();
+    console.println(F("===== TankRC Console ====="));
+    console.println(F("1) Feature toggles"));
+    console.println(F("2) Diagnostics & tests"));
+    console.println(F("0) Exit"));
+    printIntPrompt("Select option", 0);
+}
+
 void runMainMenu() {
-    beginWizardSession();
-    bool exit = false;
-    while (!exit && !wizardAbortRequested_) {
-        console.println();
-        console.println(F("===== TankRC Console ====="));
-        console.println(F("1) Feature toggles"));
-        console.println(F("2) Diagnostics & tests"));
-        console.println(F("0) Exit"));
-        const int choice = promptInt("Select option", 0);
-        if (wizardAbortRequested_) {
+    beginWizardSession(WizardMode::MainMenu);
+    enterMainMenu();
+}
+
+void handleMainMenuLine(String line) {
+    line.trim();
+    String lower = line;
+    lower.toLowerCase();
+    if (isQuit(lower)) {
+        finishWizardSession();
+        return;
+    }
+    switch (line.isEmpty() ? 0 : line.toInt()) {
+        case 1:
+            returnToMainMenu_ = true;
+            runFeatureWizard();
+            break;
+        case 2:
+            returnToMainMenu_ = true;
+            enterTestMenu();
+            break;
+        case 0:
+            finishWizardSession();
+            break;
+        default:
+            console.println(F("Unknown selection."));
+            enterMainMenu();
+            break;
+    }
+}
+
+void handleWizardLine(const String& line) {
+    switch (wizard_) {
+        case WizardMode::MainMenu:
+            handleMainMenuLine(line);
+            break;
+        case WizardMode::Features:
+            handleFeatureLine(line);
+            break;
+        case WizardMode::TestMenu:
+            handleTestMenuLine(line);
+            break;
+        case WizardMode::MotorTest:
+        case WizardMode::SoundTest:
+            handleTestRunningLine(line);
+            break;
+        case WizardMode::None:
             break;
-        }
-        switch (choice) {
-            case 1:
-                finishWizardSession();
-                runFeatureWizard();
-                beginWizardSession();
-                break;
-            case 2:
-                finishWizardSession();
-                runTestWizard();
-                beginWizardSession();
-                break;
-            case 0:
-                exit = true;
-                break;
-            default:
-                console.println(F("Unknown selection."));
-                break;
-        }
     }
-    finishWizardSession();
 }
 
 void handleCommand(String line) {
@@ -424,6 +908,38 @@ void handleCommand(String line) {
         runTestWizard();
         return;
     }
+    if (lower == "cal" || lower == "calibrate" || lower.startsWith("cal ")) {
+        const int space = lower.indexOf(' ');
+        handleCalibrationCommand(space < 0 ? String() : lower.substring(space + 1));
+        return;
+    }
+    if (lower == "lat" || lower == "latency" || lower.startsWith("lat ")) {
+        const int space = lower.indexOf(' ');
+        handleLatencyCommand(space < 0 ? String() : lower.substring(space + 1));
+        return;
+    }
+    if (lower == "events" || lower.startsWith("events ")) {
+        const int space = lower.indexOf(' ');
+        handleEventsCommand(space < 0 ? String() : lower.substring(space + 1));
+        return;
+    }
+    if (lower == "journal" || lower.startsWith("journal ")) {
+        const int space = lower.indexOf(' ');
+        handleJournalCommand(space < 0 ? String() : lower.substring(space + 1));
+        return;
+    }
+    if (lower == "top") {
+        printTop();
+        return;
+    }
+    if (lower == "link") {
+        printLinkStats();
+        return;
+    }
+    if (lower == "telem" || lower == "telemetry") {
+        printSlaveTelemetry();
+        return;
+    }
     if (lower == "save" || lower == "sv") {
         saveConfigToStore();
         return;
@@ -445,9 +961,16 @@ void handleCommand(String line) {
 }
 
 void processLine(const String& line, ConsoleSource source) {
-    if (wizardActive_ && source != wizardSource_) {
-        console.println(F("Wizard already running on another console. Exit it before sending new commands."));
-        console.printPrompt();
+    if (wizard_ != WizardMode::None) {
+        if (source != wizardSource_) {
+            console.println(F("Wizard already running on another console. Exit it before sending new commands."));
+            console.printPrompt();
+            return;
+        }
+        handleWizardLine(line);
+        if (wizard_ == WizardMode::None) {
+            console.printPrompt();
+        }
         return;
     }
 
@@ -459,7 +982,9 @@ void processLine(const String& line, ConsoleSource source) {
     }
     activeSource_ = source;
     handleCommand(trimmed);
-    console.printPrompt();
+    if (wizard_ == WizardMode::None) {
+        console.printPrompt();
+    }
 }
 }  // namespace
 
@@ -491,10 +1016,29 @@ void update() {
             inputBuffer_ += c;
         }
     }
+
+    if (wizardInputPending_) {
+        wizardInputPending_ = false;
+        const String line = wizardInputBuffer_;
+        wizardInputBuffer_.clear();
+        processLine(line, wizardSource_);
+    }
+    serviceTest();
 }
 
 bool isWizardActive() {
-    return wizardActive_;
+    return wizard_ != WizardMode::None;
+}
+
+TestOverride testOverride() {
+    const std::uint32_t word = testOverrideWord_;
+    TestOverride out{};
+    out.drive = (word & kOverrideDrive) != 0;
+    out.throttle = static_cast<float>(static_cast<std::int8_t>((word >> 8) & 0xFFU)) / 100.0F;
+    out.turn = static_cast<float>(static_cast<std::int8_t>((word >> 16) & 0xFFU)) / 100.0F;
+    out.sound = (word & kOverrideSound) != 0;
+    out.soundOn = (word & kOverrideSoundOn) != 0;
+    return out;
 }
 
 void addConsoleTap(Print* tap) {
@@ -522,7 +1066,7 @@ void setRemoteConsoleTap(Print* tap) {
 #endif
 
 void injectRemoteLine(const String& line, ConsoleSource source) {
-    if (wizardActive_) {
+    if (wizard_ != WizardMode::None) {
         if (source == wizardSource_) {
             wizardInputBuffer_ = line;
             wizardInputPending_ = true;
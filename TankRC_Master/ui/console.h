@@ -10,6 +10,10 @@ namespace Control {
 class DriveController;
 }
 
+namespace Comms {
+class RadioLink;
+}
+
 namespace Features {
 class SoundFx;
 }
@@ -24,13 +28,25 @@ struct Context {
     Storage::ConfigStore* store = nullptr;
     Control::DriveController* drive = nullptr;
     Features::SoundFx* sound = nullptr;
+    Comms::RadioLink* radio = nullptr;
 };
 
 using ApplyConfigCallback = void (*)();
 
+// Outputs requested by a running console test. The control task applies them in place of
+// the RC command, so tests go through the normal pipeline instead of driving the slave.
+struct TestOverride {
+    bool drive = false;
+    float throttle = 0.0F;
+    float turn = 0.0F;
+    bool sound = false;
+    bool soundOn = false;
+};
+
 void begin(const Context& ctx, ApplyConfigCallback applyCallback);
 void update();
 bool isWizardActive();
+TestOverride testOverride();
 void addConsoleTap(Print* tap);
 void removeConsoleTap(Print* tap);
 #if TANKRC_ENABLE_NETWORK
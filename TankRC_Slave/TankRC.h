@@ -9,4 +9,6 @@
 #include "drivers/motor_driver.h"
 #include "health/health.h"
 #include "../events/event_bus.h"
+#include "../profiler/profiler.h"
+#include "../scheduler/scheduler.h"
 #include "features/lighting.h"
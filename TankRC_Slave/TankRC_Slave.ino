@@ -20,35 +20,30 @@ static Control::DriveController driveController;
 static Config::RuntimeConfig runtimeConfig = Config::makeDefaultConfig();
 static Comms::SlaveEndpoint slaveEndpoint;
 
-struct Task {
-    void (*fn)();
-    std::uint32_t intervalMs;
-    std::uint32_t lastRunMs;
-};
-
-void taskServiceLink();
+void taskDriveOutputs();
 void taskControlLoop();
 
-Task tasks[] = {
-    {taskServiceLink, 5, 0},
-    {taskControlLoop, 5, 0},
+// UART frames are handled as they arrive (see loop()); only the motor ramp, lighting and
+// status run on a fixed period.
+const Scheduler::TaskConfig kTasks[] = {
+    {"drive", taskDriveOutputs, 5000, 1, 1500},
+    {"control", taskControlLoop, 5000, 0, 1000},
 };
+static Scheduler::Scheduler scheduler;
 
 #if FEATURE_EVENT_LOG
-void logEvent(const Events::Event& event) {
-    Serial.print(F("[EVT] "));
-    switch (event.type) {
-        case Events::EventType::LowBattery:
-            Serial.printf("Battery low: %.2f V\n", event.f1);
-            break;
-        case Events::EventType::BatteryRecovered:
-            Serial.printf("Battery recovered: %.2f V\n", event.f1);
-            break;
-        default:
-            Serial.println(F("Event received"));
-            break;
-    }
+void logLowBattery(const Events::LowBattery& event, std::uint32_t) {
+    Serial.printf("[EVT] Battery low: %.2f V\n", event.voltage);
+}
+
+void logBatteryRecovered(const Events::BatteryRecovered& event, std::uint32_t) {
+    Serial.printf("[EVT] Battery recovered: %.2f V\n", event.voltage);
 }
+
+using EventRoutes = Events::Dispatcher<Events::On<Events::LowBattery, logLowBattery>,
+                                       Events::On<Events::BatteryRecovered, logBatteryRecovered>>;
+#else
+using EventRoutes = Events::Dispatcher<>;
 #endif  // FEATURE_EVENT_LOG
 
 void setup() {
@@ -59,29 +54,27 @@ void setup() {
 
     Hal::begin(runtimeConfig);
     Health::setStatus(Health::HealthCode::Ok, "Slave startup");
-#if FEATURE_EVENT_LOG
-    Events::subscribe(logEvent);
-#endif
+    EventRoutes::begin();
     slaveEndpoint.begin(&runtimeConfig, &driveController);
+    for (const auto& task : kTasks) {
+        scheduler.add(task);
+    }
+    slaveEndpoint.setLoopStats(&scheduler.stats(0));  // kTasks[0] is the drive task
+    scheduler.start();
     Serial.println(F("[BOOT] Slave ready. Waiting for master commands."));
 }
 
-void taskServiceLink() {
-    slaveEndpoint.loop();
+void taskDriveOutputs() {
+    slaveEndpoint.updateOutputs();
 }
 
 void taskControlLoop() {
-    Events::process();
+    EventRoutes::process();
 }
 
 void loop() {
-    const std::uint32_t now = Hal::millis32();
-    for (auto& task : tasks) {
-        if (now - task.lastRunMs >= task.intervalMs) {
-            task.lastRunMs = now;
-            task.fn();
-        }
-    }
+    slaveEndpoint.service();
+    scheduler.runDue();
     Core::serviceWatchdog();
-    Hal::delayMs(1);
+    slaveEndpoint.waitForData(scheduler.untilNextUs(micros()));
 }
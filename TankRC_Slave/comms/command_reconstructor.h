@@ -0,0 +1,68 @@
+#pragma once
+#ifndef TANKRC_COMMS_COMMAND_RECONSTRUCTOR_H
+#define TANKRC_COMMS_COMMAND_RECONSTRUCTOR_H
+
+#include <algorithm>
+#include <cstdint>
+
+namespace TankRC::Comms {
+// Turns the master's stamped command samples into a continuous drive target. A new sample
+// is used the moment it lands, so nothing waits for the next frame; until the one after
+// arrives the target follows the slope between the last two samples. That bridges one
+// lost frame (two sample periods) before holding the extrapolated value.
+class CommandReconstructor {
+  public:
+    // Samples further apart than this, by either clock, are treated as a step: no slope.
+    static constexpr std::uint32_t kMaxSampleGapUs = 50000;
+
+    void reset() { valid_ = false; }
+
+    // Returns false when `stampUs` repeats the current sample (a resend), which is ignored.
+    // The 16-bit stamp wraps every 65 ms, so a match after a long silence counts as new.
+    bool push(std::uint16_t stampUs, float throttle, float turn, std::uint32_t nowUs) {
+        if (valid_ && stampUs == stampUs_ && (nowUs - rxUs_) <= kMaxSampleGapUs) {
+            return false;
+        }
+        const auto periodUs = static_cast<std::uint16_t>(stampUs - stampUs_);
+        const bool continuous = valid_ && periodUs <= kMaxSampleGapUs && (nowUs - rxUs_) <= kMaxSampleGapUs;
+        if (continuous) {
+            const float scale = 1.0F / static_cast<float>(periodUs);
+            throttleSlope_ = (throttle - throttle_) * scale;
+            turnSlope_ = (turn - turn_) * scale;
+            horizonUs_ = 2U * periodUs;
+        } else {
+            throttleSlope_ = 0.0F;
+            turnSlope_ = 0.0F;
+            horizonUs_ = 0;
+        }
+        stampUs_ = stampUs;
+        rxUs_ = nowUs;
+        throttle_ = throttle;
+        turn_ = turn;
+        valid_ = true;
+        return true;
+    }
+
+    void sample(std::uint32_t nowUs, float& throttle, float& turn) const {
+        if (!valid_) {
+            throttle = 0.0F;
+            turn = 0.0F;
+            return;
+        }
+        const auto aheadUs = static_cast<float>(std::min(nowUs - rxUs_, horizonUs_));
+        throttle = std::clamp(throttle_ + throttleSlope_ * aheadUs, -1.0F, 1.0F);
+        turn = std::clamp(turn_ + turnSlope_ * aheadUs, -1.0F, 1.0F);
+    }
+
+  private:
+    bool valid_ = false;
+    std::uint16_t stampUs_ = 0;
+    std::uint32_t rxUs_ = 0;
+    std::uint32_t horizonUs_ = 0;
+    float throttle_ = 0.0F;
+    float turn_ = 0.0F;
+    float throttleSlope_ = 0.0F;
+    float turnSlope_ = 0.0F;
+};
+}  // namespace TankRC::Comms
+#endif  // TANKRC_COMMS_COMMAND_RECONSTRUCTOR_H
@@ -1,8 +1,11 @@
 #include "comms/slave_endpoint.h"
 
 #include <Arduino.h>
+#include <algorithm>
 #include <cstring>
+#include <esp_system.h>
 
+#include "../profiler/profiler.h"
 #include "config/pins.h"
 #include "control/drive_controller.h"
 
@@ -10,38 +13,99 @@ namespace TankRC::Comms {
 namespace {
 constexpr unsigned long kCommandTimeoutMs = 500;
 constexpr unsigned long kStatusIntervalMs = 100;
+constexpr unsigned long kBaud = 921600;
+// UART driver ring buffer, ~11 ms of line time at kBaud.
+constexpr std::size_t kRxBufferSize = 1024;
+// Idle time, in symbols, after which the UART driver reports a receive timeout. A command
+// frame ends with the line going idle, so this fires ~20 µs after its last byte.
+constexpr std::uint8_t kRxTimeoutSymbols = 2;
+// Advertised in every HelloReply.
+constexpr std::uint8_t kEncodings = SlaveProtocol::EncodingCompactCommand;
+constexpr std::uint16_t kFeatures = SlaveProtocol::FeatureTelemetry | SlaveProtocol::FeaturePing |
+                                    SlaveProtocol::FeatureLatencyEcho | SlaveProtocol::FeaturePerf;
 }  // namespace
 
+TaskHandle_t SlaveEndpoint::waiter_ = nullptr;
+
+void SlaveEndpoint::onUartReceive() {
+    if (waiter_) {
+        xTaskNotifyGive(waiter_);
+    }
+}
+
+void SlaveEndpoint::openSerial() {
+    rxPin_ = Pins::SLAVE_UART_RX;
+    txPin_ = Pins::SLAVE_UART_TX;
+    serial_->setRxBufferSize(kRxBufferSize);
+    if (rxPin_ >= 0 && txPin_ >= 0) {
+        serial_->begin(kBaud, SERIAL_8N1, rxPin_, txPin_);
+    } else {
+        serial_->begin(kBaud);
+    }
+    serial_->setRxTimeout(kRxTimeoutSymbols);
+    serial_->onReceive(onUartReceive);
+}
+
 void SlaveEndpoint::begin(Config::RuntimeConfig* config,
                           Control::DriveController* drive,
                           HardwareSerial* serial) {
     config_ = config;
     drive_ = drive;
     serial_ = serial ? serial : &Serial1;
+    waiter_ = xTaskGetCurrentTaskHandle();
     if (serial_) {
-        rxPin_ = Pins::SLAVE_UART_RX;
-        txPin_ = Pins::SLAVE_UART_TX;
-        if (rxPin_ >= 0 && txPin_ >= 0) {
-            serial_->begin(921600, SERIAL_8N1, rxPin_, txPin_);
-        } else {
-            serial_->begin(921600);
-        }
+        openSerial();
     }
     if (config_ && drive_) {
         drive_->begin(*config_);
     }
     lightingEnabled_ = config_ ? config_->features.lightsEnabled : false;
-    resetParser();
+    codec_.attach(serial_);
 }
 
-void SlaveEndpoint::loop() {
+void SlaveEndpoint::service() {
     if (!serial_ || !drive_) {
         return;
     }
+    static const Profiler::SectionId profile = Profiler::registerSection("uart rx");
+    Profiler::Scope scope(profile);
 
-    while (serial_->available()) {
-        std::uint8_t byte = static_cast<std::uint8_t>(serial_->read());
-        processByte(byte);
+    using Routes = SlaveProtocol::FrameTable<
+        SlaveProtocol::On<SlaveProtocol::FrameType::Config, SlaveProtocol::ConfigPayload, &SlaveEndpoint::receiveConfig,
+                          &SlaveEndpoint::rejectConfig>,
+        SlaveProtocol::On<SlaveProtocol::FrameType::CompactCommand, SlaveProtocol::CompactCommandPayload,
+                          &SlaveEndpoint::handleCompactCommand>,
+        SlaveProtocol::On<SlaveProtocol::FrameType::Lighting, SlaveProtocol::LightingCommand, &SlaveEndpoint::handleLighting>,
+        SlaveProtocol::On<SlaveProtocol::FrameType::Ping, SlaveProtocol::PingPayload, &SlaveEndpoint::sendPong>,
+        SlaveProtocol::On<SlaveProtocol::FrameType::TelemetrySubscribe, SlaveProtocol::TelemetrySubscribePayload,
+                          &SlaveEndpoint::handleTelemetrySubscribe>,
+        SlaveProtocol::On<SlaveProtocol::FrameType::Command, SlaveProtocol::CommandPayload, &SlaveEndpoint::handleFullCommand>,
+        SlaveProtocol::On<SlaveProtocol::FrameType::Hello, SlaveProtocol::HelloPayload, &SlaveEndpoint::handleHello>>;
+    const unsigned long now = Hal::millis32();
+    if ((now - lastFrameMs_) > kCommandTimeoutMs) {
+        // The master has been silent; its sequence may have restarted or wrapped.
+        codec_.resetSequence();
+    }
+    // Everything drained in this pass was already waiting in the UART driver.
+    frameRxUs_ = micros();
+    if (codec_.receive<Routes>(*this) > 0) {
+        lastFrameMs_ = now;
+    }
+}
+
+void SlaveEndpoint::waitForData(std::uint32_t timeoutUs) {
+    if (!serial_ || timeoutUs == 0 || serial_->available()) {
+        return;
+    }
+    // A notification that landed since the last drain is still pending, so a frame that
+    // arrived between service() and here wakes us straight away. The timer ends waits that
+    // a tick-based timeout would round down to nothing.
+    wake_.wait(timeoutUs);
+}
+
+void SlaveEndpoint::updateOutputs() {
+    if (!serial_ || !drive_) {
+        return;
     }
 
     const unsigned long now = Hal::millis32();
@@ -49,73 +113,62 @@ void SlaveEndpoint::loop() {
         currentCommand_ = {};
         lightingInput_ = {};
         lightingEnabled_ = false;
+        reconstructor_.reset();
+    } else {
+        reconstructor_.sample(micros(), currentCommand_.throttle, currentCommand_.turn);
+        lightingInput_.steering = currentCommand_.turn;
+        lightingInput_.throttle = currentCommand_.throttle;
     }
-
     drive_->setCommand(currentCommand_);
+
     drive_->update();
+    traceApply();
     Hal::setLightingEnabled(lightingEnabled_);
     Hal::updateLighting(lightingInput_);
 
     if ((now - lastStatusMs_) >= kStatusIntervalMs) {
         sendStatus();
+        sendPerf();
         lastStatusMs_ = now;
     }
+    sendTelemetry(now);
 }
 
-void SlaveEndpoint::processByte(std::uint8_t byte) {
-    switch (state_) {
-        case ParseState::Magic:
-            if (byte == SlaveProtocol::kMagic) {
-                state_ = ParseState::Type;
-            }
-            break;
-        case ParseState::Type:
-            currentType_ = byte;
-            state_ = ParseState::Length;
-            break;
-        case ParseState::Length:
-            expectedLength_ = byte;
-            payloadPos_ = 0;
-            checksum_ = static_cast<std::uint8_t>(currentType_) ^ expectedLength_;
-            if (expectedLength_ > payload_.size()) {
-                resetParser();
-            } else if (expectedLength_ == 0) {
-                state_ = ParseState::Checksum;
-            } else {
-                state_ = ParseState::Payload;
-            }
-            break;
-        case ParseState::Payload:
-            payload_[payloadPos_++] = byte;
-            checksum_ ^= byte;
-            if (payloadPos_ >= expectedLength_) {
-                state_ = ParseState::Checksum;
-            }
-            break;
-        case ParseState::Checksum:
-            if (checksum_ == byte) {
-                processFrame(currentType_, expectedLength_);
-            }
-            resetParser();
-            break;
+void SlaveEndpoint::receiveConfig(const SlaveProtocol::ConfigPayload& payload) {
+    const std::uint32_t hash = SlaveProtocol::configHash(payload);
+    // Retransmits of the active config are only acked; re-applying would restart the
+    // drive ramps and reopen the UART for nothing.
+    if (hash != configHash_) {
+        handleConfig(payload);
+        configHash_ = hash;
     }
+    sendConfigAck(hash, true);
 }
 
-void SlaveEndpoint::processFrame(std::uint8_t type, std::uint8_t length) {
-    if (type == static_cast<std::uint8_t>(SlaveProtocol::FrameType::Config) &&
-        length == sizeof(SlaveProtocol::ConfigPayload)) {
-        SlaveProtocol::ConfigPayload payload{};
-        std::memcpy(&payload, payload_.data(), sizeof(payload));
-        handleConfig(payload);
-        return;
-    }
+void SlaveEndpoint::handleHello(const SlaveProtocol::HelloPayload& hello) {
+    // The slave accepts every encoding it lists whatever the verdict; the master decides
+    // which ones to send from the reply.
+    SlaveProtocol::HelloReplyPayload reply{};
+    reply.slave = SlaveProtocol::makeHello(kEncodings, kFeatures);
+    const auto result = SlaveProtocol::checkHello(reply.slave, hello);
+    reply.result = static_cast<std::uint8_t>(result);
+    reply.encodings =
+        result == SlaveProtocol::HelloResult::Ok ? static_cast<std::uint8_t>(reply.slave.encodings & hello.encodings) : 0;
+    helloSeen_ = true;
+    codec_.send(SlaveProtocol::FrameType::HelloReply, reply);
+}
 
-    if (type == static_cast<std::uint8_t>(SlaveProtocol::FrameType::Command) &&
-        length == sizeof(SlaveProtocol::CommandPayload)) {
-        SlaveProtocol::CommandPayload payload{};
-        std::memcpy(&payload, payload_.data(), sizeof(payload));
-        handleCommand(payload);
-    }
+void SlaveEndpoint::rejectConfig(std::uint8_t) {
+    sendConfigAck(0, false);
+}
+
+void SlaveEndpoint::handleCompactCommand(const SlaveProtocol::CompactCommandPayload& payload) {
+    handleCommand(payload.stampUs, SlaveProtocol::fromQ15(payload.throttle), SlaveProtocol::fromQ15(payload.turn));
+}
+
+void SlaveEndpoint::handleFullCommand(const SlaveProtocol::CommandPayload& payload) {
+    handleLighting(payload.lighting);
+    handleCommand(payload.stampUs, payload.throttle, payload.turn);
 }
 
 void SlaveEndpoint::handleConfig(const SlaveProtocol::ConfigPayload& payload) {
@@ -132,13 +185,7 @@ void SlaveEndpoint::handleConfig(const SlaveProtocol::ConfigPayload& payload) {
         const bool pinsChanged = (rxPin_ != Pins::SLAVE_UART_RX) || (txPin_ != Pins::SLAVE_UART_TX);
         if (pinsChanged) {
             serial_->end();
-            rxPin_ = Pins::SLAVE_UART_RX;
-            txPin_ = Pins::SLAVE_UART_TX;
-            if (rxPin_ >= 0 && txPin_ >= 0) {
-                serial_->begin(921600, SERIAL_8N1, rxPin_, txPin_);
-            } else {
-                serial_->begin(921600);
-            }
+            openSerial();
         }
     }
     Hal::applyConfig(*config_);
@@ -148,19 +195,63 @@ void SlaveEndpoint::handleConfig(const SlaveProtocol::ConfigPayload& payload) {
     }
 }
 
-void SlaveEndpoint::handleCommand(const SlaveProtocol::CommandPayload& payload) {
-    currentCommand_.throttle = payload.throttle;
-    currentCommand_.turn = payload.turn;
-    lightingInput_.steering = payload.turn;
-    lightingInput_.throttle = payload.throttle;
-    lightingInput_.ultrasonicLeft = payload.lighting.ultrasonicLeft;
-    lightingInput_.ultrasonicRight = payload.lighting.ultrasonicRight;
-    lightingInput_.status = static_cast<Comms::RcStatusMode>(payload.lighting.status);
-    lightingInput_.hazard = (payload.lighting.flags & SlaveProtocol::LightingHazard) != 0;
-    lightingInput_.rcConnected = (payload.lighting.flags & SlaveProtocol::LightingRcLinked) != 0;
-    lightingInput_.wifiConnected = (payload.lighting.flags & SlaveProtocol::LightingWifiLinked) != 0;
-    lightingEnabled_ = (payload.lighting.flags & SlaveProtocol::LightingEnabled) != 0;
+void SlaveEndpoint::handleLighting(const SlaveProtocol::LightingCommand& lighting) {
+    lightingInput_.ultrasonicLeft = lighting.ultrasonicLeft;
+    lightingInput_.ultrasonicRight = lighting.ultrasonicRight;
+    lightingInput_.status = static_cast<Comms::RcStatusMode>(lighting.status);
+    lightingInput_.hazard = (lighting.flags & SlaveProtocol::LightingHazard) != 0;
+    lightingInput_.rcConnected = (lighting.flags & SlaveProtocol::LightingRcLinked) != 0;
+    lightingInput_.wifiConnected = (lighting.flags & SlaveProtocol::LightingWifiLinked) != 0;
+    lightingEnabled_ = (lighting.flags & SlaveProtocol::LightingEnabled) != 0;
+}
+
+void SlaveEndpoint::handleTelemetrySubscribe(const SlaveProtocol::TelemetrySubscribePayload& payload) {
+    telemetry_ = payload;
+    // Everything newly subscribed goes out on the next drive tick.
+    const unsigned long now = Hal::millis32();
+    for (std::size_t i = 0; i < SlaveProtocol::kTelemetryGroupCount; ++i) {
+        telemetrySentMs_[i] = now - telemetry_.periodMs[i];
+    }
+}
+
+void SlaveEndpoint::handleCommand(std::uint16_t stampUs, float throttle, float turn) {
     lastCommandMs_ = Hal::millis32();
+    if (!reconstructor_.push(stampUs, throttle, turn, frameRxUs_)) {
+        return;
+    }
+    currentCommand_.throttle = throttle;
+    currentCommand_.turn = turn;
+    lightingInput_.steering = turn;
+    lightingInput_.throttle = throttle;
+    if (drive_) {
+        drive_->setCommand(currentCommand_);
+    }
+    if (!applyPending_) {
+        // Later frames landing before the motors update ride on the same PWM write; keep
+        // the oldest so the trace reports the worst case.
+        pendingSeq_ = codec_.rxSeq();
+        pendingRxUs_ = frameRxUs_;
+        applyPending_ = true;
+    }
+}
+
+void SlaveEndpoint::traceApply() {
+    if (!applyPending_) {
+        return;
+    }
+    const std::uint32_t writeUs = Hal::lastMotorWriteUs();
+    const auto elapsed = static_cast<std::int32_t>(writeUs - pendingRxUs_);
+    if (elapsed < 0) {
+        // Motor update skipped (zero dt); wait for the next write.
+        return;
+    }
+    applyPending_ = false;
+    appliedSeq_ = pendingSeq_;
+    echoValid_ = true;
+    applyUs_ = static_cast<std::uint32_t>(elapsed);
+    if (applyUs_ > applyMaxUs_) {
+        applyMaxUs_ = applyUs_;
+    }
 }
 
 void SlaveEndpoint::sendStatus() {
@@ -169,22 +260,141 @@ void SlaveEndpoint::sendStatus() {
     }
     SlaveProtocol::StatusPayload status{};
     status.batteryVoltage = drive_->readBatteryVoltage();
-    const auto type = SlaveProtocol::FrameType::Status;
-    serial_->write(SlaveProtocol::kMagic);
-    serial_->write(static_cast<std::uint8_t>(type));
-    const std::uint8_t length = sizeof(status);
-    serial_->write(length);
-    const std::uint8_t* payload = reinterpret_cast<const std::uint8_t*>(&status);
-    serial_->write(payload, length);
-    const std::uint8_t sum = SlaveProtocol::checksum(type, length, payload);
-    serial_->write(sum);
-}
-
-void SlaveEndpoint::resetParser() {
-    state_ = ParseState::Magic;
-    currentType_ = 0;
-    expectedLength_ = 0;
-    payloadPos_ = 0;
-    checksum_ = 0;
+    status.echoSeq = appliedSeq_;
+    status.flags = static_cast<std::uint8_t>((echoValid_ ? SlaveProtocol::StatusEchoValid : 0) |
+                                            (helloSeen_ ? SlaveProtocol::StatusHelloSeen : 0));
+    status.applyUs = applyUs_;
+    status.applyMaxUs = applyMaxUs_;
+    status.rx = codec_.rxCounters();
+    status.configHash = configHash_;
+    for (std::size_t i = 0; i < SlaveProtocol::kTelemetryGroupCount; ++i) {
+        if (telemetry_.periodMs[i] > 0) {
+            status.telemetryGroups |= SlaveProtocol::telemetryBit(static_cast<SlaveProtocol::TelemetryGroup>(i));
+        }
+    }
+    applyMaxUs_ = 0;
+    codec_.send(SlaveProtocol::FrameType::Status, status);
+}
+
+void SlaveEndpoint::sendConfigAck(std::uint32_t hash, bool accepted) {
+    if (!serial_) {
+        return;
+    }
+    SlaveProtocol::ConfigAckPayload ack{};
+    ack.hash = hash;
+    ack.accepted = accepted ? 1 : 0;
+    codec_.send(SlaveProtocol::FrameType::ConfigAck, ack);
+}
+
+void SlaveEndpoint::sendPong(const SlaveProtocol::PingPayload& ping) {
+    if (!serial_) {
+        return;
+    }
+    SlaveProtocol::PongPayload pong{};
+    pong.masterUs = ping.masterUs;
+    pong.id = ping.id;
+    pong.slaveRxUs = frameRxUs_;
+    pong.slaveTxUs = micros();
+    codec_.send(SlaveProtocol::FrameType::Pong, pong);
+}
+
+void SlaveEndpoint::sendPerf() {
+    const std::size_t total = Profiler::sectionCount();
+    if (!serial_ || total == 0) {
+        return;
+    }
+    if (perfIndex_ >= total) {
+        perfIndex_ = 0;
+    }
+    const Profiler::Summary summary = Profiler::summary(perfIndex_);
+    SlaveProtocol::PerfPayload perf{};
+    perf.index = perfIndex_;
+    perf.total = static_cast<std::uint8_t>(total);
+    std::memcpy(perf.name, summary.name, sizeof(perf.name));
+    perf.count = summary.count;
+    perf.minUs = summary.minUs;
+    perf.avgUs = summary.avgUs;
+    perf.maxUs = summary.maxUs;
+    perf.p99Us = summary.p99Us;
+    perf.loadPermille = summary.loadPermille;
+    codec_.send(SlaveProtocol::FrameType::Perf, perf);
+    ++perfIndex_;
+}
+
+void SlaveEndpoint::sendTelemetry(unsigned long now) {
+    if (!serial_ || !drive_) {
+        return;
+    }
+    std::array<std::uint8_t, SlaveProtocol::kMaxPayload> frame{};
+    SlaveProtocol::TelemetryHeader header{};
+    header.stampUs = micros();
+    std::size_t length = sizeof(header);
+    auto append = [&](SlaveProtocol::TelemetryGroup group, const void* data) {
+        const std::size_t size = SlaveProtocol::telemetryGroupSize(group);
+        std::memcpy(&frame[length], data, size);
+        length += size;
+        header.groups |= SlaveProtocol::telemetryBit(group);
+    };
+    for (std::size_t i = 0; i < SlaveProtocol::kTelemetryGroupCount; ++i) {
+        const std::uint16_t periodMs = telemetry_.periodMs[i];
+        if (periodMs == 0 || (now - telemetrySentMs_[i]) < periodMs) {
+            continue;
+        }
+        telemetrySentMs_[i] = now;
+        const auto group = static_cast<SlaveProtocol::TelemetryGroup>(i);
+        switch (group) {
+            case SlaveProtocol::TelemetryGroup::Motors: {
+                const Hal::MotorState left = Hal::leftMotorState();
+                const Hal::MotorState right = Hal::rightMotorState();
+                const SlaveProtocol::TelemetryMotors motors{left.target, left.output, right.target, right.output};
+                append(group, &motors);
+                break;
+            }
+            case SlaveProtocol::TelemetryGroup::Pid: {
+                const auto& left = drive_->leftPid().terms();
+                const auto& right = drive_->rightPid().terms();
+                const SlaveProtocol::TelemetryPid pid{{left.p, left.i, left.d}, {right.p, right.i, right.d}};
+                append(group, &pid);
+                break;
+            }
+            case SlaveProtocol::TelemetryGroup::Loop: {
+                SlaveProtocol::TelemetryLoop loop{};
+                if (loopStats_) {
+                    loop.runs = loopStats_->runs;
+                    loop.overruns = loopStats_->overruns;
+                    loop.missed = loopStats_->missed;
+                    loop.lastExecUs = loopStats_->lastExecUs;
+                    loop.maxExecUs = loopStats_->maxExecUs;
+                    loop.maxJitterUs = loopStats_->maxJitterUs;
+                }
+                append(group, &loop);
+                break;
+            }
+            case SlaveProtocol::TelemetryGroup::I2c: {
+                const Hal::I2cHealth health = Hal::i2cHealth();
+                SlaveProtocol::TelemetryI2c i2c{};
+                i2c.pcaErrors = health.pcaErrors;
+                i2c.pcfErrors = health.pcfErrors;
+                i2c.pcaReady = health.pcaReady ? 1 : 0;
+                i2c.pcfReady = health.pcfReady ? 1 : 0;
+                append(group, &i2c);
+                break;
+            }
+            case SlaveProtocol::TelemetryGroup::System: {
+                SlaveProtocol::TelemetrySystem system{};
+                system.uptimeMs = now;
+                system.resetReason = static_cast<std::uint8_t>(esp_reset_reason());
+                append(group, &system);
+                break;
+            }
+            default:
+                break;
+        }
+    }
+    if (header.groups == 0) {
+        return;
+    }
+    std::memcpy(frame.data(), &header, sizeof(header));
+    codec_.send(SlaveProtocol::FrameType::Telemetry, frame.data(), static_cast<std::uint8_t>(length));
 }
 }  // namespace TankRC::Comms
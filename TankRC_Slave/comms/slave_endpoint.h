@@ -3,13 +3,18 @@
 #define TANKRC_COMMS_SLAVE_ENDPOINT_H
 
 #include <array>
+#include <cstdint>
 
 #include <HardwareSerial.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
 
+#include "../scheduler/scheduler.h"
+#include "comms/command_reconstructor.h"
 #include "comms/drive_types.h"
-#include "comms/slave_protocol.h"
 #include "config/runtime_config.h"
 #include "hal/hal.h"
+#include "../link/frame_codec.h"
 
 namespace TankRC::Control {
 class DriveController;
@@ -21,32 +26,77 @@ class SlaveEndpoint {
     void begin(Config::RuntimeConfig* config,
                Control::DriveController* drive,
                HardwareSerial* serial = &Serial1);
-    void loop();
+    // Drains the UART and acts on every complete frame immediately; commands reach
+    // DriveController::setCommand() here rather than on the next drive tick.
+    void service();
+    // Drive/ramp update, command timeout, lighting and status; runs on its own period.
+    void updateOutputs();
+    // Blocks the calling task until UART data arrives or `timeoutUs` elapses, sub-tick waits
+    // included, so loop() never spins towards a deadline less than a tick away.
+    void waitForData(std::uint32_t timeoutUs);
+    // Stats of the task that calls updateOutputs(), reported in the Loop telemetry group.
+    void setLoopStats(const Scheduler::TaskStats* stats) { loopStats_ = stats; }
 
   private:
-    enum class ParseState { Magic, Type, Length, Payload, Checksum };
+    static void onUartReceive();
 
-    void processByte(std::uint8_t byte);
-    void processFrame(std::uint8_t type, std::uint8_t length);
+    void openSerial();
+    // Frame handlers, routed by the table in service().
+    void receiveConfig(const SlaveProtocol::ConfigPayload& payload);
+    void rejectConfig(std::uint8_t length);
+    // Answers with this firmware's HelloPayload and the verdict on the master's.
+    void handleHello(const SlaveProtocol::HelloPayload& hello);
+    void handleCompactCommand(const SlaveProtocol::CompactCommandPayload& payload);
+    void handleFullCommand(const SlaveProtocol::CommandPayload& payload);
     void handleConfig(const SlaveProtocol::ConfigPayload& payload);
-    void handleCommand(const SlaveProtocol::CommandPayload& payload);
+    // Resends of the current sample only refresh the command timeout.
+    void handleCommand(std::uint16_t stampUs, float throttle, float turn);
+    void handleLighting(const SlaveProtocol::LightingCommand& lighting);
+    void handleTelemetrySubscribe(const SlaveProtocol::TelemetrySubscribePayload& payload);
     void sendStatus();
-    void resetParser();
+    void sendConfigAck(std::uint32_t hash, bool accepted);
+    void sendPong(const SlaveProtocol::PingPayload& ping);
+    void sendPerf();
+    // Sends one Telemetry frame holding every subscribed group that has come due.
+    void sendTelemetry(unsigned long now);
+    void traceApply();
+
+    // Task blocked in waitForData(); woken from the UART driver's receive callback.
+    static TaskHandle_t waiter_;
+    Scheduler::WakeTimer wake_{};
 
     Config::RuntimeConfig* config_ = nullptr;
     Control::DriveController* drive_ = nullptr;
     HardwareSerial* serial_ = nullptr;
-    ParseState state_ = ParseState::Magic;
-    std::uint8_t currentType_ = 0;
-    std::uint8_t expectedLength_ = 0;
-    std::uint8_t payloadPos_ = 0;
-    std::uint8_t checksum_ = 0;
-    std::array<std::uint8_t, SlaveProtocol::kMaxPayload> payload_{};
+    SlaveProtocol::FrameCodec<HardwareSerial> codec_{};
+    unsigned long lastFrameMs_ = 0;
     Comms::DriveCommand currentCommand_{};
+    CommandReconstructor reconstructor_{};
     Features::LightingInput lightingInput_{};
     bool lightingEnabled_ = false;
     unsigned long lastCommandMs_ = 0;
     unsigned long lastStatusMs_ = 0;
+    // Latency trace for the most recent command: stamped when its frame completes and
+    // closed on the first PWM write after that.
+    std::uint32_t frameRxUs_ = 0;
+    std::uint8_t pendingSeq_ = 0;
+    std::uint32_t pendingRxUs_ = 0;
+    bool applyPending_ = false;
+    std::uint8_t appliedSeq_ = 0;
+    bool echoValid_ = false;
+    std::uint32_t applyUs_ = 0;
+    std::uint32_t applyMaxUs_ = 0;
+    std::uint8_t perfIndex_ = 0;
+    // Telemetry subscription; forgotten on reset, which the master sees in the status.
+    SlaveProtocol::TelemetrySubscribePayload telemetry_{};
+    std::array<unsigned long, SlaveProtocol::kTelemetryGroupCount> telemetrySentMs_{};
+    const Scheduler::TaskStats* loopStats_ = nullptr;
+    // Hash of the last ConfigPayload applied, echoed in every status frame. Zero after a
+    // reset, which tells the master to push its config again.
+    std::uint32_t configHash_ = 0;
+    // Set by the first Hello after boot; its absence in the status tells the master to
+    // say hello again.
+    bool helloSeen_ = false;
     int rxPin_ = -1;
     int txPin_ = -1;
 };
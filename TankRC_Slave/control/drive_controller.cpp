@@ -2,7 +2,7 @@
 
 #include "config/settings.h"
 #include "control/drive_controller.h"
-#include "events/event_bus.h"
+#include "../events/event_bus.h"
 #include "health/health.h"
 
 namespace TankRC::Control {
@@ -62,13 +62,13 @@ void DriveController::update() {
     if (voltage < 11.0F) {
         if (!batteryLowNotified) {
             batteryLowNotified = true;
-            Events::publish({Events::EventType::LowBattery, Hal::millis32(), 0, voltage});
+            Events::publish(Events::LowBattery{voltage}, Hal::millis32());
             Health::setStatus(Health::HealthCode::LowBattery, "Battery low");
         }
         Hal::stopMotors();
     } else if (batteryLowNotified && voltage > 11.5F) {
         batteryLowNotified = false;
-        Events::publish({Events::EventType::BatteryRecovered, Hal::millis32(), 0, voltage});
+        Events::publish(Events::BatteryRecovered{voltage}, Hal::millis32());
         Health::setStatus(Health::HealthCode::Ok, "Battery recovered");
     } else if (!batteryLowNotified) {
         Health::setStatus(Health::HealthCode::Ok, "Outputs nominal");
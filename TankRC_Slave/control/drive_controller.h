@@ -25,6 +25,10 @@ class DriveController {
     void setCommand(const Comms::DriveCommand& command);
     void update();
     float readBatteryVoltage();
+#if !TANKRC_USE_DRIVE_PROXY
+    const PID& leftPid() const { return leftPid_; }
+    const PID& rightPid() const { return rightPid_; }
+#endif
 
   private:
     const Config::RuntimeConfig* config_ = nullptr;
@@ -11,11 +11,15 @@ float PID::update(float error, float dt) {
     integral_ += error * dt;
     const float derivative = (error - prevError_) / dt;
     prevError_ = error;
-    return (kp_ * error) + (ki_ * integral_) + (kd_ * derivative);
+    terms_.p = kp_ * error;
+    terms_.i = ki_ * integral_;
+    terms_.d = kd_ * derivative;
+    return terms_.p + terms_.i + terms_.d;
 }
 
 void PID::reset() {
     integral_ = 0.0F;
     prevError_ = 0.0F;
+    terms_ = {};
 }
 }  // namespace TankRC::Control
@@ -3,9 +3,17 @@
 namespace TankRC::Control {
 class PID {
   public:
+    struct Terms {
+        float p = 0.0F;
+        float i = 0.0F;
+        float d = 0.0F;
+    };
+
     void configure(float kp, float ki, float kd);
     float update(float error, float dt);
     void reset();
+    // Contribution of each term to the most recent update().
+    const Terms& terms() const { return terms_; }
 
   private:
     float kp_ = 0.0F;
@@ -13,5 +21,6 @@ class PID {
     float kd_ = 0.0F;
     float integral_ = 0.0F;
     float prevError_ = 0.0F;
+    Terms terms_{};
 };
 }  // namespace TankRC::Control
@@ -71,7 +71,7 @@ void MotorDriver::stop() {
     driveChannel(motorB_, 0.0F);
 }
 
-void MotorDriver::driveChannel(const ChannelPins& pins, float percent) const {
+void MotorDriver::driveChannel(const ChannelPins& pins, float percent) {
     if (!pins.valid()) {
         return;
     }
@@ -85,6 +85,7 @@ void MotorDriver::driveChannel(const ChannelPins& pins, float percent) const {
         if (pins.pwm >= 0) {
             analogWrite(pins.pwm, 0);
         }
+        lastWriteUs_ = micros();
         return;
     }
 
@@ -94,6 +95,7 @@ void MotorDriver::driveChannel(const ChannelPins& pins, float percent) const {
     if (pins.pwm >= 0) {
         analogWrite(pins.pwm, static_cast<int>(magnitude * 255.0F));
     }
+    lastWriteUs_ = micros();
 }
 
 void MotorDriver::writeDigital(int pin, bool high) const {
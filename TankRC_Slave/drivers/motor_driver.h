@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+
 #include "config/runtime_config.h"
 
 namespace TankRC::Drivers {
@@ -20,9 +22,14 @@ class MotorDriver {
     void setTarget(float percent);
     void update(float dtSeconds);
     void stop();
+    // micros() of the most recent PWM write; used to close out command latency traces.
+    std::uint32_t lastWriteUs() const { return lastWriteUs_; }
+    float target() const { return target_; }
+    // Ramp output actually being driven, chasing target().
+    float output() const { return current_; }
 
   private:
-    void driveChannel(const ChannelPins& pins, float percent) const;
+    void driveChannel(const ChannelPins& pins, float percent);
     void writeDigital(int pin, bool high) const;
 
     ChannelPins motorA_{};
@@ -32,5 +39,6 @@ class MotorDriver {
     float target_ = 0.0F;
     float current_ = 0.0F;
     float rampRate_ = 1.5F;
+    std::uint32_t lastWriteUs_ = 0;
 };
 }  // namespace TankRC::Drivers
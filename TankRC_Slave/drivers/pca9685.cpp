@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <cmath>
 
+#include "../profiler/profiler.h"
 #include "drivers/pca9685.h"
 
 namespace TankRC::Drivers {
@@ -53,20 +54,28 @@ void Pca9685::setChannelNormalized(int channel, float normalized) {
 }
 
 void Pca9685::write8(std::uint8_t reg, std::uint8_t value) {
+    static const Profiler::SectionId profile = Profiler::registerSection("i2c");
+    Profiler::Scope scope(profile);
     wire_->beginTransmission(address_);
     wire_->write(reg);
     wire_->write(value);
-    wire_->endTransmission();
+    if (wire_->endTransmission() != 0) {
+        ++errors_;
+    }
 }
 
 void Pca9685::setPwm(std::uint8_t channel, std::uint16_t on, std::uint16_t off) {
+    static const Profiler::SectionId profile = Profiler::registerSection("i2c");
+    Profiler::Scope scope(profile);
     wire_->beginTransmission(address_);
     wire_->write(LED0_ON_L + 4 * channel);
     wire_->write(on & 0xFF);
     wire_->write(on >> 8);
     wire_->write(off & 0xFF);
     wire_->write(off >> 8);
-    wire_->endTransmission();
+    if (wire_->endTransmission() != 0) {
+        ++errors_;
+    }
 }
 
 void Pca9685::setFrequency(std::uint16_t freq) {
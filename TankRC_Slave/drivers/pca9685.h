@@ -12,6 +12,9 @@ class Pca9685 {
     bool begin(std::uint8_t address = 0x40, std::uint16_t frequency = 1000, TwoWire* wire = nullptr);
     void setChannelValue(int channel, std::uint16_t value);
     void setChannelNormalized(int channel, float normalized);
+    bool ready() const { return ready_; }
+    // Writes the chip did not acknowledge, since boot.
+    std::uint32_t errors() const { return errors_; }
 
   private:
     void write8(std::uint8_t reg, std::uint8_t value);
@@ -22,6 +25,7 @@ class Pca9685 {
     std::uint16_t frequency_ = 1000;
     TwoWire* wire_ = nullptr;
     bool ready_ = false;
+    std::uint32_t errors_ = 0;
 };
 }  // namespace TankRC::Drivers
 #endif  // TANKRC_DRIVERS_PCA9685_H
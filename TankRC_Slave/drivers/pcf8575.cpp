@@ -1,3 +1,4 @@
+#include "../profiler/profiler.h"
 #include "drivers/pcf8575.h"
 
 namespace TankRC::Drivers {
@@ -28,10 +29,15 @@ void Pcf8575::writePin(int index, bool high) {
 }
 
 bool Pcf8575::flush() {
+    static const Profiler::SectionId profile = Profiler::registerSection("i2c");
+    Profiler::Scope scope(profile);
     wire_->beginTransmission(address_);
     wire_->write(state_ & 0xFF);
     wire_->write((state_ >> 8) & 0xFF);
     ready_ = wire_->endTransmission() == 0;
+    if (!ready_) {
+        ++errors_;
+    }
     return ready_;
 }
 }  // namespace TankRC::Drivers
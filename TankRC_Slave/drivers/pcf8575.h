@@ -9,6 +9,8 @@ class Pcf8575 {
     bool begin(std::uint8_t address = 0x20, TwoWire* wire = nullptr);
     void writePin(int index, bool high);
     bool ready() const { return ready_; }
+    // Writes the chip did not acknowledge, since boot.
+    std::uint32_t errors() const { return errors_; }
 
   private:
     bool flush();
@@ -17,5 +19,6 @@ class Pcf8575 {
     std::uint8_t address_ = 0x20;
     bool ready_ = false;
     std::uint16_t state_ = 0xFFFF;
+    std::uint32_t errors_ = 0;
 };
 }  // namespace TankRC::Drivers
@@ -30,6 +30,7 @@ class Lighting {
     void begin(const Config::RuntimeConfig& config, TwoWire* bus = nullptr);
     void setFeatureEnabled(bool enabled);
     void update(const LightingInput& input);
+    const Drivers::Pca9685& pwm() const { return pca_; }
 
   private:
     void setAllLights(const Color& color);
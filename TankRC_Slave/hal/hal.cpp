@@ -152,6 +152,30 @@ void stopMotors() {
     rightMotor.stop();
 }
 
+std::uint32_t lastMotorWriteUs() {
+    // The right side is always written after the left, so it marks the end of an update.
+    return rightMotor.lastWriteUs();
+}
+
+MotorState leftMotorState() {
+    return MotorState{leftMotor.target(), leftMotor.output()};
+}
+
+MotorState rightMotorState() {
+    return MotorState{rightMotor.target(), rightMotor.output()};
+}
+
+I2cHealth i2cHealth() {
+    I2cHealth health{};
+    health.pcfErrors = pinExpander.errors();
+    health.pcfReady = expanderReady && pinExpander.ready();
+#if FEATURE_LIGHTS
+    health.pcaErrors = lighting.pwm().errors();
+    health.pcaReady = lightingReady && lighting.pwm().ready();
+#endif
+    return health;
+}
+
 float readBatteryVoltage() {
     return battery.readVoltage();
 }
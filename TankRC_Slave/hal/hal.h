@@ -6,6 +6,18 @@
 #include "features/lighting.h"
 
 namespace TankRC::Hal {
+struct MotorState {
+    float target = 0.0F;
+    float output = 0.0F;  // ramped value being driven
+};
+
+struct I2cHealth {
+    std::uint32_t pcaErrors = 0;
+    std::uint32_t pcfErrors = 0;
+    bool pcaReady = false;
+    bool pcfReady = false;
+};
+
 void begin(const Config::RuntimeConfig& config);
 void applyConfig(const Config::RuntimeConfig& config);
 
@@ -15,6 +27,10 @@ void delayMs(std::uint32_t ms);
 void setMotorOutputs(float left, float right);
 void updateMotorController(float dtSeconds);
 void stopMotors();
+std::uint32_t lastMotorWriteUs();
+MotorState leftMotorState();
+MotorState rightMotorState();
+I2cHealth i2cHealth();
 
 float readBatteryVoltage();
 
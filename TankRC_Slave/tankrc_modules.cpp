@@ -14,4 +14,6 @@
 #include "hal/hal.cpp"
 #include "health/health.cpp"
 #include "events/event_bus.cpp"
+#include "../profiler/profiler.cpp"
+#include "../scheduler/scheduler.cpp"
 #endif
@@ -1,76 +1,271 @@
 #include "event_bus.h"
 
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <cstddef>
+#include <cstring>
+
+#ifdef ARDUINO
+#include <esp_attr.h>
+#else
+#define IRAM_ATTR
+#endif
 
 namespace TankRC::Events {
 namespace {
-constexpr std::size_t kQueueSize = 16;
-constexpr std::size_t kMaxHandlers = 8;
+constexpr std::uint32_t kCriticalCapacity = 8;
+constexpr std::uint32_t kNormalCapacity = 16;
+
+struct TypePolicy {
+    Priority priority;
+    bool coalesce;  // repeats while one is still queued replace its payload
+};
 
-std::array<Event, kQueueSize> queue{};
-std::size_t head = 0;
-std::size_t tail = 0;
+// Indexed by EventType. Paired events (lost/restored, low/recovered) share a lane so they
+// are never dispatched out of order.
+constexpr TypePolicy kPolicies[kEventTypeCount] = {
+    {Priority::Normal, false},   // DriveModeChanged
+    {Priority::Critical, false}, // RcSignalLost
+    {Priority::Critical, false}, // RcSignalRestored
+    {Priority::Critical, false}, // LowBattery
+    {Priority::Critical, false}, // BatteryRecovered
+    {Priority::Critical, false}, // TipOverDetected
+    {Priority::Normal, true},    // ObstacleAhead
+};
 
-std::array<EventHandler, kMaxHandlers> handlers{};
-std::size_t handlerCount = 0;
+// Bounded MPSC ring (per-slot sequence numbers). For queue position `pos` in lap
+// `base = pos & ~kIndexMask`, a slot's sequence is `base` while free and `base + 1` once
+// the event is written. Producers claim positions with a CAS on `tail_`; the consumer
+// releases a slot by advancing its sequence to the next lap. Zero-initialised storage is a
+// valid empty queue, so nothing needs to run before the first publish.
+template <std::uint32_t Capacity>
+class Lane {
+    static_assert((Capacity & (Capacity - 1U)) == 0, "positions wrap with uint32, so capacity must be a power of two");
 
-bool queueEmpty() {
-    return head == tail;
+  public:
+    IRAM_ATTR bool push(const Event& event) {
+        std::uint32_t pos = tail_.load(std::memory_order_relaxed);
+        Slot* slot = nullptr;
+        while (true) {
+            slot = &slots_[pos & kIndexMask];
+            const std::uint32_t sequence = slot->sequence.load(std::memory_order_acquire);
+            const auto lag = static_cast<std::int32_t>(sequence - (pos & ~kIndexMask));
+            if (lag == 0) {
+                if (tail_.compare_exchange_weak(pos, pos + 1U, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (lag < 0) {
+                // Still holds the event from the previous lap: the lane is full.
+                return false;
+            } else {
+                pos = tail_.load(std::memory_order_relaxed);
+            }
+        }
+        slot->event = event;
+        slot->sequence.store((pos & ~kIndexMask) + 1U, std::memory_order_release);
+        noteDepth(std::min(pos + 1U - head_.load(std::memory_order_relaxed), Capacity));
+        return true;
+    }
+
+    bool pop(Event& event) {
+        const std::uint32_t pos = head_.load(std::memory_order_relaxed);
+        Slot& slot = slots_[pos & kIndexMask];
+        const std::uint32_t lap = pos & ~kIndexMask;
+        if (slot.sequence.load(std::memory_order_acquire) != lap + 1U) {
+            return false;
+        }
+        event = slot.event;
+        slot.sequence.store(lap + Capacity, std::memory_order_release);
+        head_.store(pos + 1U, std::memory_order_relaxed);
+        return true;
+    }
+
+    std::atomic<std::uint32_t> published{0};
+    std::atomic<std::uint32_t> dropped{0};
+    std::atomic<std::uint32_t> coalesced{0};
+    std::atomic<std::uint32_t> highWater{0};
+
+  private:
+    static constexpr std::uint32_t kIndexMask = Capacity - 1U;
+
+    struct Slot {
+        std::atomic<std::uint32_t> sequence{0};
+        Event event{};
+    };
+
+    IRAM_ATTR void noteDepth(std::uint32_t depth) {
+        std::uint32_t seen = highWater.load(std::memory_order_relaxed);
+        while (depth > seen && !highWater.compare_exchange_weak(seen, depth, std::memory_order_relaxed)) {
+        }
+    }
+
+    std::array<Slot, Capacity> slots_{};
+    std::atomic<std::uint32_t> tail_{0};
+    std::atomic<std::uint32_t> head_{0};  // written by the consumer only
+};
+
+// Newest event of a coalescing type. The queued entry only marks the type as pending; on
+// dequeue the consumer delivers what is stored here, so a burst arrives as its latest
+// value. `sequence` is odd while a producer writes, and a producer that finds it odd leaves
+// the slot to the one already inside, whose value is from the same instant.
+struct LatestSlot {
+    std::atomic<std::uint32_t> sequence{0};
+    std::atomic<std::uint32_t> timestampMs{0};
+    std::atomic<std::uint32_t> payload{0};
+};
+static_assert(kPayloadBytes == sizeof(std::uint32_t), "LatestSlot stores the payload as one word");
+
+Lane<kCriticalCapacity> criticalLane;
+Lane<kNormalCapacity> normalLane;
+// Set while a coalescing type has an event queued; cleared by the consumer on dequeue,
+// before it reads the latest slot.
+std::array<std::atomic<bool>, kEventTypeCount> queued{};
+std::array<LatestSlot, kEventTypeCount> latest{};
+std::uint32_t dispatchedCount = 0;
+std::atomic<std::uint32_t> subscriptions{~0U};  // everything until a dispatcher narrows it
+
+IRAM_ATTR void storeLatest(const Event& event) {
+    LatestSlot& slot = latest[static_cast<std::size_t>(event.type)];
+    std::uint32_t sequence = slot.sequence.load(std::memory_order_relaxed);
+    if ((sequence & 1U) != 0 ||
+        !slot.sequence.compare_exchange_strong(sequence, sequence + 1U, std::memory_order_acquire)) {
+        return;
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+    std::uint32_t payload = 0;
+    std::memcpy(&payload, event.payload, sizeof(payload));
+    slot.timestampMs.store(event.timestampMs, std::memory_order_relaxed);
+    slot.payload.store(payload, std::memory_order_relaxed);
+    slot.sequence.store(sequence + 2U, std::memory_order_seq_cst);
 }
 
-bool queueFull() {
-    return ((tail + 1) % kQueueSize) == head;
+// Leaves `event` (the copy that was queued) untouched when a producer is mid-write; that
+// producer finds the queued flag already cleared and queues its own entry.
+void loadLatest(Event& event) {
+    const LatestSlot& slot = latest[static_cast<std::size_t>(event.type)];
+    const std::uint32_t before = slot.sequence.load(std::memory_order_seq_cst);
+    if ((before & 1U) != 0) {
+        return;
+    }
+    const std::uint32_t timestampMs = slot.timestampMs.load(std::memory_order_relaxed);
+    const std::uint32_t payload = slot.payload.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.sequence.load(std::memory_order_relaxed) != before) {
+        return;
+    }
+    event.timestampMs = timestampMs;
+    std::memcpy(event.payload, &payload, sizeof(payload));
 }
 
-void enqueue(const Event& event) {
-    if (queueFull()) {
-        head = (head + 1) % kQueueSize;
+template <typename L>
+IRAM_ATTR void publishTo(L& lane, const Event& event, bool coalesce) {
+    const auto type = static_cast<std::size_t>(event.type);
+    if (coalesce) {
+        // Store first: if an entry is still queued, the consumer will pick this value up.
+        storeLatest(event);
+        if (queued[type].exchange(true, std::memory_order_seq_cst)) {
+            lane.coalesced.fetch_add(1U, std::memory_order_relaxed);
+            return;
+        }
+    }
+    if (lane.push(event)) {
+        lane.published.fetch_add(1U, std::memory_order_relaxed);
+        return;
+    }
+    if (coalesce) {
+        queued[type].store(false, std::memory_order_release);
     }
-    queue[tail] = event;
-    tail = (tail + 1) % kQueueSize;
+    lane.dropped.fetch_add(1U, std::memory_order_relaxed);
+}
+
+template <typename L>
+LaneStats snapshot(const L& lane) {
+    LaneStats out{};
+    out.published = lane.published.load(std::memory_order_relaxed);
+    out.dropped = lane.dropped.load(std::memory_order_relaxed);
+    out.coalesced = lane.coalesced.load(std::memory_order_relaxed);
+    out.highWater = lane.highWater.load(std::memory_order_relaxed);
+    return out;
+}
+
+template <typename L>
+void resetLane(L& lane) {
+    lane.published.store(0, std::memory_order_relaxed);
+    lane.dropped.store(0, std::memory_order_relaxed);
+    lane.coalesced.store(0, std::memory_order_relaxed);
+    lane.highWater.store(0, std::memory_order_relaxed);
 }
 
 bool dequeue(Event& event) {
-    if (queueEmpty()) {
+    if (!criticalLane.pop(event) && !normalLane.pop(event)) {
         return false;
     }
-    event = queue[head];
-    head = (head + 1) % kQueueSize;
+    const auto type = static_cast<std::size_t>(event.type);
+    if (type < kEventTypeCount && kPolicies[type].coalesce) {
+        // Clear before reading: a publish that lands after this queues a fresh entry rather
+        // than folding into the one being delivered.
+        queued[type].store(false, std::memory_order_seq_cst);
+        loadLatest(event);
+    }
     return true;
 }
 }  // namespace
 
-void subscribe(EventHandler handler) {
-    if (!handler) {
+IRAM_ATTR void publish(const Event& event) {
+    const auto type = static_cast<std::size_t>(event.type);
+    if (type >= kEventTypeCount || (subscriptions.load(std::memory_order_relaxed) & topicBit(event.type)) == 0) {
         return;
     }
-    for (std::size_t i = 0; i < handlerCount; ++i) {
-        if (handlers[i] == handler) {
-            return;
-        }
+    const TypePolicy& policy = kPolicies[type];
+    if (policy.priority == Priority::Critical) {
+        publishTo(criticalLane, event, policy.coalesce);
+    } else {
+        publishTo(normalLane, event, policy.coalesce);
     }
-    if (handlerCount < kMaxHandlers) {
-        handlers[handlerCount++] = handler;
+}
+
+// Checks the critical lane before every event, so one published mid-drain jumps the rest
+// of the normal backlog.
+bool poll(Event& event) {
+    if (!dequeue(event)) {
+        return false;
     }
+    ++dispatchedCount;
+    return true;
 }
 
-void publish(const Event& event) {
-    enqueue(event);
+void setSubscriptions(std::uint32_t topicMask) {
+    subscriptions.store(topicMask, std::memory_order_relaxed);
 }
 
-void process() {
+void clear() {
+    // Producers may still be mid-publish, so drain instead of resetting the indices.
     Event event{};
     while (dequeue(event)) {
-        for (std::size_t i = 0; i < handlerCount; ++i) {
-            if (handlers[i]) {
-                handlers[i](event);
-            }
-        }
     }
 }
 
-void clear() {
-    head = tail = 0;
+Priority priorityOf(EventType type) {
+    const auto index = static_cast<std::size_t>(type);
+    return index < kEventTypeCount ? kPolicies[index].priority : Priority::Normal;
+}
+
+Stats stats() {
+    Stats out{};
+    out.lanes[static_cast<std::size_t>(Priority::Critical)] = snapshot(criticalLane);
+    out.lanes[static_cast<std::size_t>(Priority::Normal)] = snapshot(normalLane);
+    out.dispatched = dispatchedCount;
+    return out;
+}
+
+void resetStats() {
+    resetLane(criticalLane);
+    resetLane(normalLane);
+    dispatchedCount = 0;
+}
+
+const char* toString(Priority priority) {
+    return priority == Priority::Critical ? "critical" : "normal";
 }
 }  // namespace TankRC::Events
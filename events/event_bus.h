@@ -1,6 +1,10 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
+
+#include "../profiler/profiler.h"
 
 namespace TankRC::Events {
 enum class EventType {
@@ -12,18 +16,144 @@ enum class EventType {
     TipOverDetected,
     ObstacleAhead,
 };
+constexpr std::size_t kEventTypeCount = static_cast<std::size_t>(EventType::ObstacleAhead) + 1;
+
+constexpr std::uint32_t topicBit(EventType type) {
+    return 1U << static_cast<std::uint32_t>(type);
+}
+
+// Typed payloads, one per topic. Each names its EventType so publish() and On<> can route
+// it without a switch.
+struct DriveModeChanged {
+    static constexpr EventType kType = EventType::DriveModeChanged;
+    std::int32_t mode = 0;
+};
+
+struct RcSignalLost {
+    static constexpr EventType kType = EventType::RcSignalLost;
+};
+
+struct RcSignalRestored {
+    static constexpr EventType kType = EventType::RcSignalRestored;
+};
+
+struct LowBattery {
+    static constexpr EventType kType = EventType::LowBattery;
+    float voltage = 0.0F;
+};
+
+struct BatteryRecovered {
+    static constexpr EventType kType = EventType::BatteryRecovered;
+    float voltage = 0.0F;
+};
+
+struct TipOverDetected {
+    static constexpr EventType kType = EventType::TipOverDetected;
+};
+
+struct ObstacleAhead {
+    static constexpr EventType kType = EventType::ObstacleAhead;
+    float level = 0.0F;  // 0 = touching, 1 = clear
+};
+
+constexpr std::size_t kPayloadBytes = 4;
 
+// What travels through the queue: the topic, a timestamp and the topic's payload bytes.
 struct Event {
     EventType type;
     std::uint32_t timestampMs = 0;
-    std::int32_t i1 = 0;
-    float f1 = 0.0F;
+    alignas(4) std::uint8_t payload[kPayloadBytes]{};
+
+    template <typename Topic>
+    static Event make(const Topic& value, std::uint32_t timestampMs) {
+        static_assert(sizeof(Topic) <= kPayloadBytes, "event payloads must fit the queue slot");
+        Event event{Topic::kType, timestampMs};
+        std::memcpy(event.payload, &value, sizeof(Topic));
+        return event;
+    }
+
+    template <typename Topic>
+    Topic as() const {
+        Topic value{};
+        std::memcpy(&value, payload, sizeof(Topic));
+        return value;
+    }
+};
+
+// Safety events travel in their own lane so a burst of routine events can never crowd
+// them out; poll() always drains the critical lane first.
+enum class Priority : std::uint8_t { Critical, Normal };
+constexpr std::size_t kPriorityCount = 2;
+
+struct LaneStats {
+    std::uint32_t published = 0;  // accepted into the lane
+    std::uint32_t dropped = 0;    // rejected because the lane was full
+    std::uint32_t coalesced = 0;  // folded into a queued event of the same type, which now carries it
+    std::uint32_t highWater = 0;  // deepest the lane has been since the last reset
 };
 
-using EventHandler = void (*)(const Event&);
+struct Stats {
+    LaneStats lanes[kPriorityCount]{};
+    std::uint32_t dispatched = 0;  // handed to the dispatcher by poll()
+};
 
-void subscribe(EventHandler handler);
+// Lock-free; safe from ISRs and from any task on either core. Topics outside the
+// subscription mask are discarded before they take a queue slot. When a lane is full the
+// new event is dropped and counted rather than overwriting one still being read.
 void publish(const Event& event);
-void process();
+
+template <typename Topic>
+void publish(const Topic& payload, std::uint32_t timestampMs) {
+    publish(Event::make(payload, timestampMs));
+}
+
+// Single consumer: call from one task only. Most code uses Dispatcher::process() instead.
+bool poll(Event& event);
+void setSubscriptions(std::uint32_t topicMask);
 void clear();
+Priority priorityOf(EventType type);
+Stats stats();
+void resetStats();
+const char* toString(Priority priority);
+
+// Compile-time route: calls Handler for every Topic event.
+template <typename TopicT, void (*Handler)(const TopicT&, std::uint32_t timestampMs)>
+struct On {
+    using Topic = TopicT;
+
+    static void call(const Event& event) {
+        Handler(event.as<Topic>(), event.timestampMs);
+    }
+};
+
+// The routing table is a type, e.g.
+//   using Routes = Events::Dispatcher<Events::On<Events::LowBattery, onLowBattery>>;
+// Dispatch compiles to one compare per route, topics nobody routes are filtered at
+// publish, and there is no handler table in RAM.
+template <typename... Routes>
+class Dispatcher {
+  public:
+    static constexpr std::uint32_t kTopicMask = (0U | ... | topicBit(Routes::Topic::kType));
+
+    static void begin() {
+        setSubscriptions(kTopicMask);
+    }
+
+    static void process() {
+        static const Profiler::SectionId profile = Profiler::registerSection("events");
+        Profiler::Scope scope(profile);
+        Event event{};
+        while (poll(event)) {
+            (dispatch<Routes>(event), ...);
+        }
+    }
+
+  private:
+    template <typename Route>
+    static void dispatch(const Event& event) {
+        if (event.type == Route::Topic::kType) {
+            Route::call(event);
+        }
+    }
+};
 }  // namespace TankRC::Events
@@ -0,0 +1,298 @@
+#pragma once
+#ifndef TANKRC_LINK_FRAME_CODEC_H
+#define TANKRC_LINK_FRAME_CODEC_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "slave_protocol.h"
+
+// One framing implementation for both ends of the master<->slave link. It only needs the
+// standard library and a byte transport, so the same code runs on the host in
+// tools/link_bench.cpp.
+namespace TankRC::Comms::SlaveProtocol {
+// Pulls frames out of whatever the UART handed over in one bulk read. Hunting for the
+// magic byte is a memchr() and payload runs are copied whole, so only the header and CRC
+// bytes go through the state machine one at a time. Frames may straddle reads.
+class FrameParser {
+  public:
+    struct Frame {
+        std::uint8_t type = 0;
+        std::uint8_t seq = 0;
+        std::uint8_t length = 0;
+        const std::uint8_t* payload = nullptr;  // valid only during the callback
+    };
+
+    // Calls `onFrame(const Frame&)` for every frame whose CRC checks out, in order. CRC
+    // failures and resyncs are added to `counters`; sequence checks are left to the caller.
+    template <typename OnFrame>
+    void feed(const std::uint8_t* data, std::size_t size, LinkCounters& counters, OnFrame&& onFrame) {
+        const std::uint8_t* p = data;
+        const std::uint8_t* const end = data + size;
+        while (p < end) {
+            switch (state_) {
+                case State::Magic: {
+                    const auto* hit = static_cast<const std::uint8_t*>(std::memchr(p, kMagic, static_cast<std::size_t>(end - p)));
+                    if (hit != p && !hunting_) {
+                        hunting_ = true;
+                        ++counters.resyncs;
+                    }
+                    if (!hit) {
+                        return;
+                    }
+                    hunting_ = false;
+                    p = hit + 1;
+                    state_ = State::Type;
+                    break;
+                }
+                case State::Type:
+                    type_ = *p++;
+                    crc_ = crc16Update(kCrcInit, type_);
+                    state_ = State::Seq;
+                    break;
+                case State::Seq:
+                    seq_ = *p++;
+                    crc_ = crc16Update(crc_, seq_);
+                    length_ = fixedLength(type_);
+                    pos_ = 0;
+                    state_ = length_ > 0 ? State::Payload : State::Length;
+                    break;
+                case State::Length:
+                    length_ = *p++;
+                    crc_ = crc16Update(crc_, length_);
+                    if (length_ > kMaxPayload) {
+                        state_ = State::Magic;
+                    } else {
+                        state_ = length_ == 0 ? State::CrcLow : State::Payload;
+                    }
+                    break;
+                case State::Payload: {
+                    const auto run = std::min<std::size_t>(static_cast<std::size_t>(end - p), length_ - pos_);
+                    std::memcpy(&payload_[pos_], p, run);
+                    crc_ = crc16Update(crc_, p, run);
+                    pos_ = static_cast<std::uint8_t>(pos_ + run);
+                    p += run;
+                    if (pos_ >= length_) {
+                        state_ = State::CrcLow;
+                    }
+                    break;
+                }
+                case State::CrcLow:
+                    crcLow_ = *p++;
+                    state_ = State::CrcHigh;
+                    break;
+                case State::CrcHigh:
+                    state_ = State::Magic;
+                    if (crc_ == static_cast<std::uint16_t>(crcLow_ | (*p++ << 8))) {
+                        onFrame(Frame{type_, seq_, length_, payload_.data()});
+                    } else {
+                        ++counters.crcErrors;
+                    }
+                    break;
+            }
+        }
+    }
+
+    void reset() { state_ = State::Magic; }
+
+  private:
+    enum class State : std::uint8_t { Magic, Type, Seq, Length, Payload, CrcLow, CrcHigh };
+
+    State state_ = State::Magic;
+    bool hunting_ = false;
+    std::uint8_t type_ = 0;
+    std::uint8_t seq_ = 0;
+    std::uint8_t length_ = 0;
+    std::uint8_t pos_ = 0;
+    std::uint16_t crc_ = 0;
+    std::uint8_t crcLow_ = 0;
+    std::array<std::uint8_t, kMaxPayload> payload_{};
+};
+
+enum class DispatchResult : std::uint8_t { Handled, Unrouted, BadLength };
+
+// Compile-time route for a fixed-layout payload: Handler, a member function taking
+// `const Payload&`, runs only when the frame length matches sizeof(Payload). The optional
+// BadLength member function gets the received length instead, e.g. to nack the sender.
+template <FrameType Type, typename PayloadT, auto Handler, auto BadLength = nullptr>
+struct On {
+    using Payload = PayloadT;
+    static constexpr FrameType kType = Type;
+
+    static_assert(std::is_trivially_copyable_v<Payload>, "payloads are copied off the wire");
+    static_assert(sizeof(Payload) <= kMaxPayload, "payload must fit one frame");
+    static_assert(fixedLength(static_cast<std::uint8_t>(Type)) == 0 ||
+                      fixedLength(static_cast<std::uint8_t>(Type)) == sizeof(Payload),
+                  "frames sent without a length byte must match their fixed length");
+
+    template <typename Owner>
+    static DispatchResult call(Owner& owner, const FrameParser::Frame& frame) {
+        if (frame.length != sizeof(Payload)) {
+            if constexpr (!std::is_same_v<decltype(BadLength), std::nullptr_t>) {
+                (owner.*BadLength)(frame.length);
+            }
+            return DispatchResult::BadLength;
+        }
+        Payload payload{};
+        std::memcpy(&payload, frame.payload, sizeof(Payload));
+        (owner.*Handler)(payload);
+        return DispatchResult::Handled;
+    }
+};
+
+// Route for variable-length frames; Handler gets (payload, length) and checks the layout.
+template <FrameType Type, auto Handler>
+struct OnBytes {
+    static constexpr FrameType kType = Type;
+
+    template <typename Owner>
+    static DispatchResult call(Owner& owner, const FrameParser::Frame& frame) {
+        (owner.*Handler)(frame.payload, frame.length);
+        return DispatchResult::Handled;
+    }
+};
+
+// The routing table is a type, e.g.
+//   using Routes = SlaveProtocol::FrameTable<SlaveProtocol::On<FrameType::Pong, PongPayload, &SlaveLink::handlePong>>;
+// Declare it inside a member function so the routes can name private handlers. Dispatch
+// is one compare per route and there is no handler table in RAM.
+template <typename... Routes>
+struct FrameTable {
+    static_assert(sizeof...(Routes) > 0, "a frame table needs at least one route");
+
+    static constexpr bool uniqueTypes() {
+        const FrameType types[] = {Routes::kType...};
+        for (std::size_t i = 0; i < sizeof...(Routes); ++i) {
+            for (std::size_t j = i + 1; j < sizeof...(Routes); ++j) {
+                if (types[i] == types[j]) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+    static_assert(uniqueTypes(), "each frame type may be routed once");
+
+    template <typename Owner>
+    static DispatchResult dispatch(Owner& owner, const FrameParser::Frame& frame) {
+        DispatchResult result = DispatchResult::Unrouted;
+        ((frame.type == static_cast<std::uint8_t>(Routes::kType) ? (result = Routes::call(owner, frame), true) : false) ||
+         ...);
+        return result;
+    }
+};
+
+// Frames out of and into a byte transport: anything with `int available()`,
+// `size_t read(uint8_t*, size_t)` and `size_t write(const uint8_t*, size_t)`, so
+// HardwareSerial on the boards and a memory buffer on the host. Owns the per-direction
+// sequence numbers and receive counters; opening and configuring the transport is left to
+// the caller.
+template <typename Transport>
+class FrameCodec {
+  public:
+    // Bytes moved out of the transport per read() call.
+    static constexpr std::size_t kRxChunk = 64;
+
+    explicit FrameCodec(Transport* transport = nullptr) : transport_(transport) {}
+
+    void attach(Transport* transport) {
+        transport_ = transport;
+        parser_.reset();
+        rxSequence_.reset();
+    }
+
+    // Drains the transport and hands every CRC-clean, in-sequence frame to Table. Returns
+    // the number of frames dispatched.
+    template <typename Table, typename Owner>
+    std::size_t receive(Owner& owner) {
+        if (!transport_) {
+            return 0;
+        }
+        std::size_t frames = 0;
+        std::array<std::uint8_t, kRxChunk> chunk{};
+        while (const int available = transport_->available()) {
+            if (available < 0) {
+                break;
+            }
+            const std::size_t count =
+                transport_->read(chunk.data(), std::min<std::size_t>(static_cast<std::size_t>(available), chunk.size()));
+            if (count == 0) {
+                break;
+            }
+            parser_.feed(chunk.data(), count, rxCounters_, [&](const FrameParser::Frame& frame) {
+                if (!rxSequence_.accept(frame.seq, rxCounters_)) {
+                    return;
+                }
+                rxSeq_ = frame.seq;
+                ++frames;
+                if (Table::dispatch(owner, frame) == DispatchResult::BadLength) {
+                    ++lengthErrors_;
+                }
+            });
+        }
+        return frames;
+    }
+
+    // Encodes the frame and hands it to the transport in one write. Returns its sequence
+    // number.
+    std::uint8_t send(FrameType type, const void* payload, std::uint8_t length) {
+        const std::uint8_t seq = txSeq_++;
+        if (!transport_ || length > kMaxPayload) {
+            return seq;
+        }
+        const auto* bytes = static_cast<const std::uint8_t*>(payload);
+        std::array<std::uint8_t, kFrameOverhead + kMaxPayload> frame{};
+        std::size_t size = 0;
+        frame[size++] = kMagic;
+        frame[size++] = static_cast<std::uint8_t>(type);
+        frame[size++] = seq;
+        if (fixedLength(static_cast<std::uint8_t>(type)) == 0) {
+            frame[size++] = length;
+        }
+        if (bytes && length > 0) {
+            std::memcpy(&frame[size], bytes, length);
+        }
+        size += length;
+        // Everything after the magic byte is covered, the same bytes crc16() walks.
+        const std::uint16_t crc = crc16Update(kCrcInit, &frame[1], size - 1);
+        frame[size++] = static_cast<std::uint8_t>(crc & 0xFFU);
+        frame[size++] = static_cast<std::uint8_t>(crc >> 8);
+        transport_->write(frame.data(), size);
+        txBytes_ += static_cast<std::uint32_t>(size);
+        return seq;
+    }
+
+    template <typename Payload>
+    std::uint8_t send(FrameType type, const Payload& payload) {
+        static_assert(std::is_trivially_copyable_v<Payload>, "payloads are copied onto the wire");
+        static_assert(sizeof(Payload) <= kMaxPayload, "payload must fit one frame");
+        return send(type, &payload, static_cast<std::uint8_t>(sizeof(Payload)));
+    }
+
+    // Call after the peer has been silent long enough that its sequence may have wrapped.
+    void resetSequence() { rxSequence_.reset(); }
+
+    Transport* transport() const { return transport_; }
+    const LinkCounters& rxCounters() const { return rxCounters_; }
+    // Sequence number of the frame being (or last) dispatched.
+    std::uint8_t rxSeq() const { return rxSeq_; }
+    // Routed frames whose length did not match the payload their route expects.
+    std::uint32_t lengthErrors() const { return lengthErrors_; }
+    std::uint32_t txBytes() const { return txBytes_; }
+
+  private:
+    Transport* transport_ = nullptr;
+    FrameParser parser_{};
+    SequenceTracker rxSequence_{};
+    LinkCounters rxCounters_{};
+    std::uint8_t txSeq_ = 0;
+    std::uint8_t rxSeq_ = 0;
+    std::uint32_t lengthErrors_ = 0;
+    std::uint32_t txBytes_ = 0;
+};
+}  // namespace TankRC::Comms::SlaveProtocol
+#endif  // TANKRC_LINK_FRAME_CODEC_H
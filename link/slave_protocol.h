@@ -0,0 +1,455 @@
+#pragma once
+#ifndef TANKRC_LINK_SLAVE_PROTOCOL_H
+#define TANKRC_LINK_SLAVE_PROTOCOL_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+
+// Resolved against the including sketch; both keep the ConfigPayload structs identical.
+#include "config/runtime_config.h"
+
+// Wire format: magic, type, seq, length, payload, CRC-16 (little-endian). The CRC covers
+// type through payload; seq counts frames per direction so the receiver can spot loss.
+// Fixed-size types (see fixedLength()) leave out the length byte.
+namespace TankRC::Comms::SlaveProtocol {
+constexpr std::uint8_t kMagic = 0xA5;
+// Bumped whenever a payload layout or the meaning of a frame changes. A peer older than
+// kMinProtocolVersion is refused; firmware from before the Hello exchange never answers.
+constexpr std::uint16_t kProtocolVersion = 2;
+constexpr std::uint16_t kMinProtocolVersion = 2;
+// Sized for ConfigPayload, the largest frame; the length byte caps it at 255.
+constexpr std::size_t kMaxPayload = 160;
+static_assert(kMaxPayload <= 0xFF, "payload length travels in one byte");
+constexpr std::size_t kFrameOverhead = 6;
+
+enum LightingFlags : std::uint8_t {
+    LightingHazard = 1 << 0,
+    LightingEnabled = 1 << 1,
+    LightingRcLinked = 1 << 2,
+    LightingWifiLinked = 1 << 3,
+};
+
+enum class FrameType : std::uint8_t {
+    Config = 0x01,
+    Command = 0x02,
+    CompactCommand = 0x03,
+    Lighting = 0x04,
+    TelemetrySubscribe = 0x05,
+    Ping = 0x06,
+    Hello = 0x07,
+    Status = 0x81,
+    Perf = 0x82,
+    ConfigAck = 0x83,
+    Telemetry = 0x84,
+    Pong = 0x85,
+    HelloReply = 0x86,
+};
+
+enum StatusFlags : std::uint8_t {
+    StatusEchoValid = 1 << 0,  // echoSeq/applyUs describe a command the slave applied
+    // 1 << 1 advertised compact commands before protocol 2; Hello encodings replace it.
+    StatusHelloSeen = 1 << 2,  // the slave has answered a Hello since it booted
+};
+
+// Optional frame encodings. The master only uses one when both Hellos list it.
+enum EncodingFlags : std::uint8_t {
+    EncodingCompactCommand = 1 << 0,  // CompactCommand + separate Lighting frames
+};
+
+// Optional features the sender implements, reported for diagnostics.
+enum FeatureFlags : std::uint16_t {
+    FeatureTelemetry = 1 << 0,    // TelemetrySubscribe / Telemetry
+    FeaturePing = 1 << 1,         // Ping / Pong with both timestamps
+    FeatureLatencyEcho = 1 << 2,  // status echoes the last applied command
+    FeaturePerf = 1 << 3,         // profiler sections in Perf frames
+};
+
+// Outcome of comparing our Hello with the peer's.
+enum class HelloResult : std::uint8_t {
+    Ok,
+    PeerTooOld,      // peer version below our kMinProtocolVersion
+    PeerTooNew,      // our version below the peer's minimum
+    LayoutMismatch,  // same version, different payload structs (e.g. ConfigPayload)
+};
+
+inline const char* toString(HelloResult result) {
+    switch (result) {
+        case HelloResult::Ok:
+            return "ok";
+        case HelloResult::PeerTooOld:
+            return "peer too old";
+        case HelloResult::PeerTooNew:
+            return "peer too new";
+        case HelloResult::LayoutMismatch:
+            return "layout mismatch";
+        default:
+            return "?";
+    }
+}
+
+// Field groups of the Telemetry frame, in the order they are packed.
+enum class TelemetryGroup : std::uint8_t {
+    Motors,
+    Pid,
+    Loop,
+    I2c,
+    System,
+    Count,
+};
+
+constexpr std::size_t kTelemetryGroupCount = static_cast<std::size_t>(TelemetryGroup::Count);
+
+constexpr std::uint8_t telemetryBit(TelemetryGroup group) {
+    return static_cast<std::uint8_t>(1U << static_cast<std::uint8_t>(group));
+}
+
+inline const char* toString(TelemetryGroup group) {
+    switch (group) {
+        case TelemetryGroup::Motors:
+            return "motors";
+        case TelemetryGroup::Pid:
+            return "pid";
+        case TelemetryGroup::Loop:
+            return "loop";
+        case TelemetryGroup::I2c:
+            return "i2c";
+        case TelemetryGroup::System:
+            return "system";
+        default:
+            return "?";
+    }
+}
+
+#pragma pack(push, 1)
+struct LightingCommand {
+    float ultrasonicLeft = 1.0F;
+    float ultrasonicRight = 1.0F;
+    std::uint8_t status = 0;
+    std::uint8_t flags = 0;
+};
+
+// stampUs is the low 16 bits of master micros() when the command was produced. Repeats
+// of the same command keep its stamp, so the slave can tell new samples from resends and
+// time the gap between them.
+struct CommandPayload {
+    float throttle = 0.0F;
+    float turn = 0.0F;
+    LightingCommand lighting{};
+    std::uint16_t stampUs = 0;
+};
+
+// Q15 drive command for high-rate streaming: 11 bytes on the wire instead of 26. Lighting
+// changes slowly, so it travels separately in Lighting frames.
+struct CompactCommandPayload {
+    std::int16_t throttle = 0;
+    std::int16_t turn = 0;
+    std::uint16_t stampUs = 0;
+};
+
+// Receive-side health of one link direction. Every counter only ever grows.
+struct LinkCounters {
+    std::uint32_t frames = 0;      // frames that passed the CRC
+    std::uint32_t crcErrors = 0;
+    std::uint32_t gaps = 0;        // frames missing from the sequence
+    std::uint32_t duplicates = 0;  // repeated sequence numbers, dropped
+    std::uint32_t resyncs = 0;     // times the parser had to hunt for the next magic byte
+};
+
+struct StatusPayload {
+    float batteryVoltage = 0.0F;
+    std::uint32_t applyUs = 0;      // echoSeq's frame-received -> PWM write time
+    std::uint32_t applyMaxUs = 0;   // worst receive -> PWM time since the previous status
+    std::uint8_t echoSeq = 0;       // seq of the most recently applied command frame
+    std::uint8_t flags = 0;         // StatusFlags
+    LinkCounters rx{};              // master -> slave frames as the slave saw them
+    std::uint32_t configHash = 0;   // configHash() of the active config; 0 until one lands
+    std::uint8_t telemetryGroups = 0;  // telemetryBit()s with a non-zero subscribed period
+};
+
+// Link probe. The slave answers every Ping straight from its frame handler; the pong
+// carries its own receive/transmit times so the master can take the turnaround out of
+// the round trip and estimate the offset between the two clocks.
+struct PingPayload {
+    std::uint32_t masterUs = 0;  // master micros() when the ping was written
+    std::uint8_t id = 0;
+};
+
+struct PongPayload {
+    std::uint32_t masterUs = 0;  // echoed from the ping
+    std::uint8_t id = 0;
+    std::uint32_t slaveRxUs = 0;  // slave micros() when the ping frame completed
+    std::uint32_t slaveTxUs = 0;  // slave micros() just before the pong was written
+};
+
+// Per-group Telemetry periods in ms, indexed by TelemetryGroup; 0 turns a group off.
+struct TelemetrySubscribePayload {
+    std::uint16_t periodMs[kTelemetryGroupCount] = {};
+};
+
+// Leads every Telemetry frame; stampUs lets the master place the samples on its own clock.
+struct TelemetryHeader {
+    std::uint8_t groups = 0;     // telemetryBit()s of the groups that follow
+    std::uint32_t stampUs = 0;   // slave micros() when the groups were sampled
+};
+
+// Drive target per track (PID output) against what the motor ramp is actually driving.
+struct TelemetryMotors {
+    float leftTarget = 0.0F;
+    float leftOutput = 0.0F;
+    float rightTarget = 0.0F;
+    float rightOutput = 0.0F;
+};
+
+struct PidTerms {
+    float p = 0.0F;
+    float i = 0.0F;
+    float d = 0.0F;
+};
+
+struct TelemetryPid {
+    PidTerms left{};
+    PidTerms right{};
+};
+
+// Scheduler stats of the slave's drive task; counters grow from boot.
+struct TelemetryLoop {
+    std::uint32_t runs = 0;
+    std::uint32_t overruns = 0;
+    std::uint32_t missed = 0;
+    std::uint32_t lastExecUs = 0;
+    std::uint32_t maxExecUs = 0;
+    std::uint32_t maxJitterUs = 0;
+};
+
+// Failed I2C transactions (endTransmission() != 0) since boot.
+struct TelemetryI2c {
+    std::uint32_t pcaErrors = 0;  // PCA9685 lighting PWM
+    std::uint32_t pcfErrors = 0;  // PCF8575 motor direction expander
+    std::uint8_t pcaReady = 0;
+    std::uint8_t pcfReady = 0;
+};
+
+struct TelemetrySystem {
+    std::uint32_t uptimeMs = 0;
+    std::uint8_t resetReason = 0;  // esp_reset_reason_t
+};
+
+// One profiler section per frame; the slave walks its sections round-robin.
+struct PerfPayload {
+    std::uint8_t index = 0;
+    std::uint8_t total = 0;
+    char name[16] = {};
+    std::uint32_t count = 0;
+    std::uint32_t minUs = 0;
+    float avgUs = 0.0F;
+    std::uint32_t maxUs = 0;
+    std::uint32_t p99Us = 0;
+    std::uint16_t loadPermille = 0;
+};
+
+struct ConfigPayload {
+    Config::PinAssignments pins{};
+    Config::FeatureConfig features{};
+    Config::LightingConfig lighting{};
+};
+static_assert(sizeof(ConfigPayload) <= kMaxPayload, "config must fit one frame");
+
+// Sent by the master at start-up and after every link loss; the slave answers with its own
+// in a HelloReply. Keep the layout stable across protocol versions so mismatched firmware
+// can still say what it is.
+struct HelloPayload {
+    std::uint16_t version = 0;
+    std::uint16_t minVersion = 0;
+    std::uint8_t encodings = 0;    // EncodingFlags
+    std::uint16_t features = 0;    // FeatureFlags
+    std::uint8_t maxPayload = 0;
+    std::uint8_t configBytes = 0;  // sizeof(ConfigPayload)
+    std::uint32_t layoutHash = 0;  // layoutHash(): sizes of every payload struct
+};
+
+struct HelloReplyPayload {
+    HelloPayload slave{};
+    std::uint8_t result = 0;     // HelloResult, the slave's verdict on the master's Hello
+    std::uint8_t encodings = 0;  // EncodingFlags both ends list
+};
+
+// Sent for every Config frame that passes the CRC. A nack means the payload did not match
+// this firmware's ConfigPayload layout; the hash is 0 in that case.
+struct ConfigAckPayload {
+    std::uint32_t hash = 0;
+    std::uint8_t accepted = 0;
+};
+#pragma pack(pop)
+
+// Telemetry frame: TelemetryHeader, then each flagged group's struct in TelemetryGroup
+// order. Every group fits in one frame together.
+constexpr std::size_t telemetryGroupSize(TelemetryGroup group) {
+    switch (group) {
+        case TelemetryGroup::Motors:
+            return sizeof(TelemetryMotors);
+        case TelemetryGroup::Pid:
+            return sizeof(TelemetryPid);
+        case TelemetryGroup::Loop:
+            return sizeof(TelemetryLoop);
+        case TelemetryGroup::I2c:
+            return sizeof(TelemetryI2c);
+        case TelemetryGroup::System:
+            return sizeof(TelemetrySystem);
+        default:
+            return 0;
+    }
+}
+
+static_assert(sizeof(TelemetryHeader) + sizeof(TelemetryMotors) + sizeof(TelemetryPid) + sizeof(TelemetryLoop) + sizeof(TelemetryI2c) +
+                      sizeof(TelemetrySystem) <=
+                  kMaxPayload,
+              "telemetry groups must fit one frame");
+
+// Payload size of frame types sent without a length byte, 0 for every other type.
+constexpr std::uint8_t fixedLength(std::uint8_t type) {
+    return type == static_cast<std::uint8_t>(FrameType::CompactCommand)
+               ? static_cast<std::uint8_t>(sizeof(CompactCommandPayload))
+               : 0;
+}
+
+// Bytes on the wire for one frame of `type` carrying `length` payload bytes.
+constexpr std::size_t frameBytes(FrameType type, std::size_t length) {
+    return kFrameOverhead - (fixedLength(static_cast<std::uint8_t>(type)) > 0 ? 1 : 0) + length;
+}
+
+inline std::int16_t toQ15(float value) {
+    return static_cast<std::int16_t>(std::lround(std::clamp(value, -1.0F, 1.0F) * 32767.0F));
+}
+
+inline float fromQ15(std::int16_t value) {
+    return static_cast<float>(value) * (1.0F / 32767.0F);
+}
+
+// CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF), one table lookup per byte.
+constexpr std::uint16_t kCrcInit = 0xFFFF;
+
+namespace detail {
+constexpr std::array<std::uint16_t, 256> makeCrcTable() {
+    std::array<std::uint16_t, 256> table{};
+    for (std::size_t i = 0; i < table.size(); ++i) {
+        auto crc = static_cast<std::uint16_t>(i << 8);
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc & 0x8000U) ? static_cast<std::uint16_t>((crc << 1) ^ 0x1021U) : static_cast<std::uint16_t>(crc << 1);
+        }
+        table[i] = crc;
+    }
+    return table;
+}
+
+inline constexpr std::array<std::uint16_t, 256> kCrcTable = makeCrcTable();
+}  // namespace detail
+
+inline std::uint16_t crc16Update(std::uint16_t crc, std::uint8_t byte) {
+    return static_cast<std::uint16_t>((crc << 8) ^ detail::kCrcTable[((crc >> 8) ^ byte) & 0xFFU]);
+}
+
+inline std::uint16_t crc16Update(std::uint16_t crc, const std::uint8_t* data, std::size_t length) {
+    for (std::size_t i = 0; i < length; ++i) {
+        crc = crc16Update(crc, data[i]);
+    }
+    return crc;
+}
+
+inline std::uint16_t crc16(FrameType type, std::uint8_t seq, std::uint8_t length, const std::uint8_t* payload) {
+    std::uint16_t crc = crc16Update(kCrcInit, static_cast<std::uint8_t>(type));
+    crc = crc16Update(crc, seq);
+    if (fixedLength(static_cast<std::uint8_t>(type)) == 0) {
+        crc = crc16Update(crc, length);
+    }
+    return crc16Update(crc, payload, length);
+}
+
+// FNV-1a over the raw payload, so both boards agree on it without knowing the field layout.
+inline std::uint32_t configHash(const ConfigPayload& payload) {
+    const auto* bytes = reinterpret_cast<const std::uint8_t*>(&payload);
+    std::uint32_t hash = 2166136261UL;
+    for (std::size_t i = 0; i < sizeof(payload); ++i) {
+        hash = (hash ^ bytes[i]) * 16777619UL;
+    }
+    return hash;
+}
+
+// FNV-1a over the size of every payload struct, so two builds with the same version but a
+// different field layout still tell each other apart.
+constexpr std::uint32_t layoutHash() {
+    constexpr std::size_t sizes[] = {
+        sizeof(ConfigPayload), sizeof(CommandPayload), sizeof(CompactCommandPayload), sizeof(LightingCommand),
+        sizeof(TelemetrySubscribePayload), sizeof(PingPayload), sizeof(StatusPayload), sizeof(PerfPayload),
+        sizeof(ConfigAckPayload), sizeof(TelemetryHeader), sizeof(TelemetryMotors), sizeof(TelemetryPid),
+        sizeof(TelemetryLoop), sizeof(TelemetryI2c), sizeof(TelemetrySystem), sizeof(PongPayload),
+    };
+    std::uint32_t hash = 2166136261UL;
+    for (const std::size_t size : sizes) {
+        hash = (hash ^ static_cast<std::uint32_t>(size)) * 16777619UL;
+    }
+    return hash;
+}
+
+inline HelloPayload makeHello(std::uint8_t encodings, std::uint16_t features) {
+    HelloPayload hello{};
+    hello.version = kProtocolVersion;
+    hello.minVersion = kMinProtocolVersion;
+    hello.encodings = encodings;
+    hello.features = features;
+    hello.maxPayload = static_cast<std::uint8_t>(kMaxPayload);
+    hello.configBytes = static_cast<std::uint8_t>(sizeof(ConfigPayload));
+    hello.layoutHash = layoutHash();
+    return hello;
+}
+
+// Both ends run the same check on the other's Hello, so they reach the same verdict.
+inline HelloResult checkHello(const HelloPayload& local, const HelloPayload& peer) {
+    if (peer.version < local.minVersion) {
+        return HelloResult::PeerTooOld;
+    }
+    if (local.version < peer.minVersion) {
+        return HelloResult::PeerTooNew;
+    }
+    if (peer.version == local.version &&
+        (peer.layoutHash != local.layoutHash || peer.maxPayload != local.maxPayload)) {
+        return HelloResult::LayoutMismatch;
+    }
+    return HelloResult::Ok;
+}
+
+// Checks each CRC-clean frame's sequence number against the previous one. A jump backwards
+// means the peer rebooted, so the tracker re-anchors instead of counting ~255 lost frames.
+class SequenceTracker {
+  public:
+    // Returns false for a duplicate, which the caller should drop.
+    bool accept(std::uint8_t seq, LinkCounters& counters) {
+        ++counters.frames;
+        if (!synced_) {
+            synced_ = true;
+            last_ = seq;
+            return true;
+        }
+        const auto delta = static_cast<std::uint8_t>(seq - last_);
+        if (delta == 0) {
+            ++counters.duplicates;
+            return false;
+        }
+        if (delta < 0x80U) {
+            counters.gaps += delta - 1U;
+        }
+        last_ = seq;
+        return true;
+    }
+
+    // Call after the link has been silent long enough that the sequence may have wrapped.
+    void reset() { synced_ = false; }
+
+  private:
+    std::uint8_t last_ = 0;
+    bool synced_ = false;
+};
+}  // namespace TankRC::Comms::SlaveProtocol
+#endif  // TANKRC_LINK_SLAVE_PROTOCOL_H
@@ -0,0 +1,223 @@
+#include "profiler.h"
+
+#include <array>
+#include <atomic>
+#include <cstring>
+
+#include "core/snapshot.h"
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#else
+#include <chrono>
+#endif
+
+namespace TankRC::Profiler {
+namespace {
+// Log-linear µs histogram for the p99: exact below 8 µs, then four buckets per power of
+// two up to ~8 s. Counts are per window, so 16 bits is plenty.
+constexpr int kSubBits = 2;
+constexpr int kMaxExponent = 23;
+constexpr std::size_t kLinear = 1U << (kSubBits + 1);
+constexpr std::size_t kBuckets = kLinear + (kMaxExponent - kSubBits) * (1U << kSubBits);
+
+// Only the task that owns a section records into it; summary() is called from the network
+// task on the other core, so finished windows go out through a Snapshot.
+struct Section {
+    char name[kNameLength]{};
+    Core::Snapshot<Summary> published;
+    std::atomic<std::uint32_t> publishedMs{0};
+    std::atomic<bool> started{false};
+    std::uint32_t windowStartMs = 0;
+    std::uint32_t count = 0;
+    std::uint64_t sumTicks = 0;
+    std::uint32_t minTicks = 0;
+    std::uint32_t maxTicks = 0;
+    std::array<std::uint16_t, kBuckets> histogram{};
+};
+
+std::array<Section, kMaxSections> sections{};
+std::atomic<std::size_t> registered{0};
+std::atomic_flag registerLock = ATOMIC_FLAG_INIT;
+
+std::array<Core::Snapshot<Summary>, kMaxSections> remote{};
+std::atomic<std::size_t> remoteSections{0};
+
+#ifdef ARDUINO
+std::uint32_t ticksPerUs() {
+    static const std::uint32_t perUs = getCpuFrequencyMhz();
+    return perUs;
+}
+
+std::uint32_t nowMs() {
+    return millis();
+}
+#else
+std::uint32_t ticksPerUs() {
+    return 1000;  // steady_clock nanoseconds
+}
+
+std::uint32_t nowMs() {
+    using namespace std::chrono;
+    return static_cast<std::uint32_t>(duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count());
+}
+#endif
+
+std::size_t bucketFor(std::uint32_t us) {
+    if (us < kLinear) {
+        return us;
+    }
+    const int exponent = 31 - __builtin_clz(us);
+    if (exponent > kMaxExponent) {
+        return kBuckets - 1;
+    }
+    const std::uint32_t sub = (us >> (exponent - kSubBits)) & ((1U << kSubBits) - 1U);
+    return kLinear + static_cast<std::size_t>(exponent - kSubBits - 1) * (1U << kSubBits) + sub;
+}
+
+std::uint32_t bucketHigh(std::size_t index) {
+    if (index < kLinear) {
+        return static_cast<std::uint32_t>(index);
+    }
+    const int exponent = kSubBits + 1 + static_cast<int>((index - kLinear) >> kSubBits);
+    const std::uint32_t sub = static_cast<std::uint32_t>((index - kLinear) & ((1U << kSubBits) - 1U));
+    return (((1U << kSubBits) + sub + 1U) << (exponent - kSubBits)) - 1U;
+}
+
+void publish(Section& section, std::uint32_t now) {
+    const std::uint32_t perUs = ticksPerUs();
+    const std::uint32_t elapsedMs = now - section.windowStartMs;
+    Summary out{};
+    std::memcpy(out.name, section.name, sizeof(out.name));
+    out.count = section.count;
+    if (section.count > 0) {
+        out.minUs = section.minTicks / perUs;
+        out.maxUs = section.maxTicks / perUs;
+        out.avgUs = static_cast<float>(section.sumTicks) / static_cast<float>(section.count) / static_cast<float>(perUs);
+        const std::uint32_t target = section.count - section.count / 100U;
+        std::uint32_t seen = 0;
+        for (std::size_t i = 0; i < kBuckets; ++i) {
+            seen += section.histogram[i];
+            if (seen >= target) {
+                out.p99Us = bucketHigh(i) < out.maxUs ? bucketHigh(i) : out.maxUs;
+                break;
+            }
+        }
+        if (elapsedMs > 0) {
+            const std::uint64_t permille = section.sumTicks / (static_cast<std::uint64_t>(elapsedMs) * perUs);
+            out.loadPermille = static_cast<std::uint16_t>(permille > 1000U ? 1000U : permille);
+        }
+    }
+    section.published.write(out);
+    section.publishedMs.store(now, std::memory_order_relaxed);
+    section.windowStartMs = now;
+    section.count = 0;
+    section.sumTicks = 0;
+    section.minTicks = UINT32_MAX;
+    section.maxTicks = 0;
+    section.histogram.fill(0);
+}
+}  // namespace
+
+SectionId registerSection(const char* name) {
+    if (!name) {
+        return kInvalidSection;
+    }
+    while (registerLock.test_and_set(std::memory_order_acquire)) {
+    }
+    SectionId id = kInvalidSection;
+    const std::size_t count = registered.load(std::memory_order_relaxed);
+    for (std::size_t i = 0; i < count; ++i) {
+        if (std::strncmp(sections[i].name, name, kNameLength - 1) == 0) {
+            id = static_cast<SectionId>(i);
+            break;
+        }
+    }
+    if (id == kInvalidSection && count < kMaxSections) {
+        std::strncpy(sections[count].name, name, kNameLength - 1);
+        Summary initial{};
+        std::memcpy(initial.name, sections[count].name, sizeof(initial.name));
+        sections[count].published.write(initial);
+        sections[count].minTicks = UINT32_MAX;
+        id = static_cast<SectionId>(count);
+        registered.store(count + 1, std::memory_order_release);
+    }
+    registerLock.clear(std::memory_order_release);
+    return id;
+}
+
+std::uint32_t ticks() {
+#ifdef ARDUINO
+    return ESP.getCycleCount();
+#else
+    using namespace std::chrono;
+    return static_cast<std::uint32_t>(duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+void record(SectionId id, std::uint32_t elapsedTicks) {
+    if (id >= registered.load(std::memory_order_acquire)) {
+        return;
+    }
+    Section& section = sections[id];
+    const std::uint32_t now = nowMs();
+    if (!section.started.load(std::memory_order_relaxed)) {
+        section.windowStartMs = now;
+        section.started.store(true, std::memory_order_relaxed);
+    } else if (now - section.windowStartMs >= kWindowMs) {
+        publish(section, now);
+    }
+    ++section.count;
+    section.sumTicks += elapsedTicks;
+    if (elapsedTicks < section.minTicks) {
+        section.minTicks = elapsedTicks;
+    }
+    if (elapsedTicks > section.maxTicks) {
+        section.maxTicks = elapsedTicks;
+    }
+    auto& bucket = section.histogram[bucketFor(elapsedTicks / ticksPerUs())];
+    if (bucket < UINT16_MAX) {
+        ++bucket;
+    }
+}
+
+std::size_t sectionCount() {
+    return registered.load(std::memory_order_acquire);
+}
+
+Summary summary(SectionId id) {
+    if (id >= sectionCount()) {
+        return {};
+    }
+    const Section& section = sections[id];
+    Summary out = section.published.read();
+    if (!section.started.load(std::memory_order_relaxed) ||
+        nowMs() - section.publishedMs.load(std::memory_order_relaxed) > 2U * kWindowMs) {
+        // Windows only roll over when the section runs; a silent one has no current data.
+        Summary idle{};
+        std::memcpy(idle.name, out.name, sizeof(idle.name));
+        return idle;
+    }
+    return out;
+}
+
+void storeRemote(std::size_t index, const Summary& summary) {
+    if (index >= kMaxSections) {
+        return;
+    }
+    Summary copy = summary;
+    copy.name[kNameLength - 1] = '\0';
+    remote[index].write(copy);
+    if (index >= remoteSections.load(std::memory_order_relaxed)) {
+        remoteSections.store(index + 1, std::memory_order_release);
+    }
+}
+
+std::size_t remoteCount() {
+    return remoteSections.load(std::memory_order_acquire);
+}
+
+Summary remoteSummary(std::size_t index) {
+    return index < remoteCount() ? remote[index].read() : Summary{};
+}
+}  // namespace TankRC::Profiler
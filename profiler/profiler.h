@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Fixed-memory section profiler shared by both sketches. Sections are timed with the CPU
+// cycle counter on target (steady_clock on host) and aggregated per window: every
+// kWindowMs the running min/avg/max/p99 and CPU share are published and the accumulators
+// restart. Each section must only be recorded from one task; readers on other tasks see the
+// last published window.
+namespace TankRC::Profiler {
+using SectionId = std::uint8_t;
+
+constexpr std::size_t kMaxSections = 16;
+constexpr std::size_t kNameLength = 16;
+constexpr std::uint32_t kWindowMs = 1000;
+constexpr SectionId kInvalidSection = 0xFF;
+
+struct Summary {
+    char name[kNameLength] = {};
+    std::uint32_t count = 0;
+    std::uint32_t minUs = 0;
+    float avgUs = 0.0F;
+    std::uint32_t maxUs = 0;
+    std::uint32_t p99Us = 0;
+    std::uint16_t loadPermille = 0;  // share of the window spent inside the section
+};
+
+// Returns the existing id when `name` is already registered, kInvalidSection when full.
+SectionId registerSection(const char* name);
+std::uint32_t ticks();
+void record(SectionId id, std::uint32_t elapsedTicks);
+
+std::size_t sectionCount();
+// Last complete window; a section that stopped running reads as zero samples.
+Summary summary(SectionId id);
+
+// Sections reported by the other board over the UART link.
+void storeRemote(std::size_t index, const Summary& summary);
+std::size_t remoteCount();
+Summary remoteSummary(std::size_t index);
+
+class Scope {
+  public:
+    explicit Scope(SectionId id) : id_(id), start_(ticks()) {}
+    ~Scope() { record(id_, ticks() - start_); }
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+  private:
+    SectionId id_;
+    std::uint32_t start_;
+};
+}  // namespace TankRC::Profiler
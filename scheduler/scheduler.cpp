@@ -0,0 +1,172 @@
+#include "scheduler.h"
+
+#include <Arduino.h>
+#include <esp_timer.h>
+
+namespace TankRC::Scheduler {
+namespace {
+void onWake(void* task) {
+    xTaskNotifyGive(static_cast<TaskHandle_t>(task));
+}
+
+std::int32_t since(std::uint32_t nowUs, std::uint32_t thenUs) {
+    return static_cast<std::int32_t>(nowUs - thenUs);
+}
+
+std::size_t jitterBucket(std::uint32_t us) {
+    for (std::size_t i = 0; i < kJitterBoundsUs.size(); ++i) {
+        if (us <= kJitterBoundsUs[i]) {
+            return i;
+        }
+    }
+    return kJitterBuckets - 1;
+}
+}  // namespace
+
+void WakeTimer::wait(std::uint32_t us) {
+    if (!timer_) {
+        esp_timer_create_args_t args{};
+        args.callback = onWake;
+        args.arg = xTaskGetCurrentTaskHandle();
+        args.name = "wake";
+        if (esp_timer_create(&args, &timer_) != ESP_OK) {
+            timer_ = nullptr;
+        }
+    }
+    const TickType_t backstop = static_cast<TickType_t>(us / kTickUs + 2U);
+    if (!timer_ || esp_timer_start_once(timer_, us) != ESP_OK) {
+        // No timer: a tick late beats spinning.
+        ulTaskNotifyTake(pdTRUE, backstop - 1U);
+        return;
+    }
+    ulTaskNotifyTake(pdTRUE, backstop);
+    // Woken early by someone else; a late fire only costs the next wait one early return.
+    esp_timer_stop(timer_);
+}
+
+bool Scheduler::add(const TaskConfig& config) {
+    if (count_ >= kMaxTasks || !config.fn || config.periodUs == 0) {
+        return false;
+    }
+    tasks_[count_++] = Entry{config, {}, 0, Profiler::registerSection(config.name)};
+    return true;
+}
+
+void Scheduler::start() {
+    const auto now = static_cast<std::uint32_t>(micros());
+    for (std::size_t i = 0; i < count_; ++i) {
+        tasks_[i].deadlineUs = now;
+    }
+}
+
+void Scheduler::runDue() {
+    // A task that keeps overrunning its own period can stay due forever; bound the pass so
+    // lower-priority tasks and the caller still get a turn.
+    const std::size_t maxRuns = count_ * 2U;
+    for (std::size_t runs = 0; runs < maxRuns; ++runs) {
+        Entry* entry = nextDue(static_cast<std::uint32_t>(micros()));
+        if (!entry) {
+            return;
+        }
+        run(*entry);
+    }
+}
+
+std::uint32_t Scheduler::untilNextUs(std::uint32_t nowUs) const {
+    std::uint32_t wait = UINT32_MAX;
+    for (std::size_t i = 0; i < count_; ++i) {
+        const std::int32_t remaining = since(tasks_[i].deadlineUs, nowUs);
+        if (remaining <= 0) {
+            return 0;
+        }
+        if (static_cast<std::uint32_t>(remaining) < wait) {
+            wait = static_cast<std::uint32_t>(remaining);
+        }
+    }
+    return wait;
+}
+
+void Scheduler::sleepUntilNext(std::uint32_t maxSleepUs) {
+    const auto startUs = static_cast<std::uint32_t>(micros());
+    std::uint32_t wait = untilNextUs(startUs);
+    if (wait > maxSleepUs) {
+        wait = maxSleepUs;
+    }
+    const SleepPlan plan = planSleep(wait);
+    if (plan.ticks > 0) {
+        // Whole ticks yield to other FreeRTOS tasks; rounding down means we never wake late.
+        delay(plan.ticks);
+    }
+    // The tick delay ends on a tick boundary, so re-plan the rest from the clock.
+    const std::uint32_t elapsed = static_cast<std::uint32_t>(micros()) - startUs;
+    if (elapsed >= wait) {
+        return;
+    }
+    const std::uint32_t rest = wait - elapsed;
+    if (rest > kMaxSpinUs) {
+        wake_.wait(rest);
+    } else {
+        delayMicroseconds(rest);
+    }
+}
+
+void Scheduler::resetStats() {
+    for (std::size_t i = 0; i < count_; ++i) {
+        tasks_[i].stats = {};
+    }
+}
+
+Scheduler::Entry* Scheduler::nextDue(std::uint32_t nowUs) {
+    Entry* best = nullptr;
+    for (std::size_t i = 0; i < count_; ++i) {
+        Entry& entry = tasks_[i];
+        if (since(nowUs, entry.deadlineUs) < 0) {
+            continue;
+        }
+        if (!best || entry.config.priority > best->config.priority ||
+            (entry.config.priority == best->config.priority && since(best->deadlineUs, entry.deadlineUs) > 0)) {
+            best = &entry;
+        }
+    }
+    return best;
+}
+
+void Scheduler::run(Entry& entry) {
+    auto& stats = entry.stats;
+    const auto startUs = static_cast<std::uint32_t>(micros());
+    const auto jitterUs = static_cast<std::uint32_t>(since(startUs, entry.deadlineUs));
+    ++stats.jitter[jitterBucket(jitterUs)];
+    if (jitterUs > stats.maxJitterUs) {
+        stats.maxJitterUs = jitterUs;
+    }
+
+    {
+        Profiler::Scope profile(entry.profile);
+        entry.config.fn();
+    }
+
+    const auto endUs = static_cast<std::uint32_t>(micros());
+    const std::uint32_t execUs = endUs - startUs;
+    ++stats.runs;
+    stats.lastExecUs = execUs;
+    if (execUs > stats.maxExecUs) {
+        stats.maxExecUs = execUs;
+    }
+    if (entry.config.budgetUs > 0 && execUs > entry.config.budgetUs) {
+        ++stats.overruns;
+    }
+
+    // Stay on the phase grid: the next deadline is one period after this one, not after
+    // whenever the task happened to start.
+    const std::uint32_t period = entry.config.periodUs;
+    entry.deadlineUs += period;
+    const std::int32_t late = since(endUs, entry.deadlineUs);
+    if (late <= 0) {
+        return;  // finishing exactly on the next deadline still makes it
+    }
+    // Only slots whose deadline has strictly passed are missed; the next one may be due now.
+    const std::uint32_t skipped = (static_cast<std::uint32_t>(late) - 1U) / period + 1U;
+    entry.deadlineUs += skipped * period;
+    stats.missed += skipped;
+}
+}  // namespace TankRC::Scheduler
@@ -0,0 +1,111 @@
+#pragma once
+#ifndef TANKRC_SCHEDULER_SCHEDULER_H
+#define TANKRC_SCHEDULER_SCHEDULER_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "../profiler/profiler.h"
+
+struct esp_timer;
+
+// Cooperative, deadline-driven task scheduler shared by the master and slave sketches.
+// Tasks run on a fixed phase grid (deadline += period), highest priority first when several
+// are due, and the caller sleeps until the earliest pending deadline instead of a fixed tick.
+//
+// Catch-up policy: a task that falls a whole period or more behind runs once, late, and
+// then realigns to the next grid slot. Missed periods are counted, never replayed, since a
+// stale control or input cycle is worth nothing once a newer one is due.
+namespace TankRC::Scheduler {
+struct TaskConfig {
+    const char* name = "";
+    void (*fn)() = nullptr;
+    std::uint32_t periodUs = 0;
+    std::uint8_t priority = 0;     // higher runs first when deadlines coincide
+    std::uint32_t budgetUs = 0;    // execution time above this counts as an overrun; 0 = none
+};
+
+// Release jitter (start time minus deadline) bucket upper bounds, in µs. The last bucket
+// collects everything later than the final bound.
+constexpr std::array<std::uint32_t, 7> kJitterBoundsUs{{50, 100, 250, 500, 1000, 2000, 5000}};
+constexpr std::size_t kJitterBuckets = kJitterBoundsUs.size() + 1;
+
+// vTaskDelay() only resolves whole RTOS ticks; shorter remainders block on a one-shot timer,
+// and only those too short to arm one are spun.
+constexpr std::uint32_t kTickUs = 1000;
+constexpr std::uint32_t kMaxSpinUs = 50;
+
+// How sleepUntilNext() covers a wait: whole ticks, then the rest either blocked on the wake
+// timer or spun. Kept free of RTOS calls so tools/scheduler_check.cpp can use it on a PC.
+struct SleepPlan {
+    std::uint32_t ticks = 0;
+    std::uint32_t timerUs = 0;
+    std::uint32_t spinUs = 0;
+};
+
+constexpr SleepPlan planSleep(std::uint32_t waitUs) {
+    const std::uint32_t rest = waitUs % kTickUs;
+    return SleepPlan{waitUs / kTickUs, rest > kMaxSpinUs ? rest : 0U, rest > kMaxSpinUs ? 0U : rest};
+}
+
+// Blocks the calling task on its notification until a one-shot esp_timer gives it, so a
+// sub-tick wait leaves the core to lower-priority tasks instead of spinning at the caller's
+// priority. Any other xTaskNotifyGive() to the task (a UART callback, say) ends the wait
+// early. Bound to the first task that waits on it.
+class WakeTimer {
+  public:
+    void wait(std::uint32_t us);
+
+  private:
+    esp_timer* timer_ = nullptr;
+};
+
+struct TaskStats {
+    std::uint32_t runs = 0;
+    std::uint32_t overruns = 0;      // runs that exceeded budgetUs
+    std::uint32_t missed = 0;        // periods dropped by the catch-up policy
+    std::uint32_t lastExecUs = 0;
+    std::uint32_t maxExecUs = 0;
+    std::uint32_t maxJitterUs = 0;
+    std::array<std::uint32_t, kJitterBuckets> jitter{};
+};
+
+class Scheduler {
+  public:
+    static constexpr std::size_t kMaxTasks = 8;
+
+    bool add(const TaskConfig& config);
+    // Anchors every task's first deadline at the current time; call once after adding tasks.
+    void start();
+    // Runs every task whose deadline has passed, in priority order.
+    void runDue();
+    // Microseconds until the earliest deadline, 0 when something is already due.
+    std::uint32_t untilNextUs(std::uint32_t nowUs) const;
+    // Blocks until the next deadline, capped at `maxSleepUs` so callers with other work
+    // (network, watchdog) keep getting serviced. Never busy-waits more than kMaxSpinUs, so
+    // tasks below the caller's priority on the same core still run.
+    void sleepUntilNext(std::uint32_t maxSleepUs);
+
+    std::size_t taskCount() const { return count_; }
+    const TaskConfig& config(std::size_t index) const { return tasks_[index].config; }
+    const TaskStats& stats(std::size_t index) const { return tasks_[index].stats; }
+    void resetStats();
+
+  private:
+    struct Entry {
+        TaskConfig config{};
+        TaskStats stats{};
+        std::uint32_t deadlineUs = 0;
+        Profiler::SectionId profile = Profiler::kInvalidSection;
+    };
+
+    Entry* nextDue(std::uint32_t nowUs);
+    void run(Entry& entry);
+
+    std::array<Entry, kMaxTasks> tasks_{};
+    std::size_t count_ = 0;
+    WakeTimer wake_{};
+};
+}  // namespace TankRC::Scheduler
+#endif  // TANKRC_SCHEDULER_SCHEDULER_H
@@ -0,0 +1,201 @@
+// Hammers the event bus from several producer threads while one consumer drains it, the way
+// ISRs, the control task and the network task publish on target. Each event carries its
+// producer and a per-producer sequence number; the consumer checks that nothing arrives
+// twice and that each producer's events arrive in order within a lane. Two passes: a paced
+// one that keeps fewer events in flight than the smallest lane holds, where every event
+// must arrive, and a flood where publishes that find a lane full must be counted as drops.
+// A third pass publishes a counter as a coalescing topic while the consumer drains: values
+// must never go backwards and the final one must always be delivered.
+//
+// Build from the repo root (add -fsanitize=thread to check the memory ordering too):
+//   g++ -std=c++17 -O2 -g -pthread -I . tools/event_bus_stress.cpp events/event_bus.cpp -o event_bus_stress
+// Run:
+//   ./event_bus_stress [events per producer] [producers]
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "../events/event_bus.h"
+
+namespace Ev = TankRC::Events;
+
+namespace {
+// Non-coalescing topics, one per lane, so every publish must be delivered or dropped.
+constexpr Ev::EventType kLaneTypes[] = {Ev::EventType::LowBattery, Ev::EventType::DriveModeChanged};
+constexpr std::size_t kLaneCount = sizeof(kLaneTypes) / sizeof(kLaneTypes[0]);
+
+std::uint32_t tag(std::uint32_t producer, std::uint32_t seq) {
+    return (producer << 24) | (seq & 0x00FFFFFFU);
+}
+
+std::size_t laneOf(Ev::EventType type) {
+    return type == kLaneTypes[0] ? 0 : 1;
+}
+
+// The critical lane holds 8; capping events in flight below that means nothing may drop.
+constexpr std::uint32_t kPacedInFlight = 8;
+
+bool run(const char* name, std::uint32_t producers, std::uint32_t perProducer, bool paced) {
+    Ev::clear();
+    Ev::resetStats();
+
+    std::atomic<std::uint32_t> running{producers};
+    std::atomic<std::uint32_t> inFlight{0};
+    std::vector<std::thread> threads;
+    for (std::uint32_t p = 0; p < producers; ++p) {
+        threads.emplace_back([p, perProducer, paced, &running, &inFlight] {
+            for (std::uint32_t seq = 0; seq < perProducer; ++seq) {
+                if (paced) {
+                    std::uint32_t current = inFlight.load(std::memory_order_relaxed);
+                    while (current >= kPacedInFlight ||
+                           !inFlight.compare_exchange_weak(current, current + 1U, std::memory_order_relaxed)) {
+                        std::this_thread::yield();
+                        current = inFlight.load(std::memory_order_relaxed);
+                    }
+                }
+                Ev::Event event{kLaneTypes[seq % kLaneCount], seq};
+                const std::uint32_t value = tag(p, seq);
+                std::memcpy(event.payload, &value, sizeof(value));
+                Ev::publish(event);
+                if (!paced && (seq & 0x3FU) == 0) {
+                    std::this_thread::yield();  // let the consumer catch up now and then
+                }
+            }
+            running.fetch_sub(1U, std::memory_order_release);
+        });
+    }
+
+    // Last sequence seen per producer and lane; events are numbered per producer across
+    // both lanes, so within one lane they must strictly increase.
+    std::vector<std::int64_t> last(producers * kLaneCount, -1);
+    std::vector<std::uint8_t> seen(static_cast<std::size_t>(producers) * perProducer, 0);
+    std::uint64_t received = 0;
+    std::uint64_t errors = 0;
+    Ev::Event event{};
+    while (true) {
+        const bool done = running.load(std::memory_order_acquire) == 0;
+        bool any = false;
+        while (Ev::poll(event)) {
+            any = true;
+            std::uint32_t value = 0;
+            std::memcpy(&value, event.payload, sizeof(value));
+            const std::uint32_t producer = value >> 24;
+            const std::uint32_t seq = value & 0x00FFFFFFU;
+            if (producer >= producers || seq >= perProducer || seq != event.timestampMs ||
+                event.type != kLaneTypes[seq % kLaneCount]) {
+                if (errors++ < 10) {
+                    std::printf("corrupt event: type %d, tag %08x, stamp %u\n", static_cast<int>(event.type), value,
+                                event.timestampMs);
+                }
+                continue;
+            }
+            auto& flag = seen[static_cast<std::size_t>(producer) * perProducer + seq];
+            if (flag++ != 0 && errors++ < 10) {
+                std::printf("duplicate: producer %u seq %u\n", producer, seq);
+            }
+            auto& previous = last[producer * kLaneCount + laneOf(event.type)];
+            if (static_cast<std::int64_t>(seq) <= previous && errors++ < 10) {
+                std::printf("out of order: producer %u seq %u after %lld\n", producer, seq,
+                            static_cast<long long>(previous));
+            }
+            previous = seq;
+            ++received;
+            if (paced) {
+                inFlight.fetch_sub(1U, std::memory_order_relaxed);
+            }
+        }
+        if (done && !any) {
+            break;
+        }
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    const Ev::Stats stats = Ev::stats();
+    std::uint64_t published = 0;
+    std::uint64_t dropped = 0;
+    for (const auto& lane : stats.lanes) {
+        published += lane.published;
+        dropped += lane.dropped;
+    }
+    const std::uint64_t attempts = static_cast<std::uint64_t>(producers) * perProducer;
+    std::printf("%-6s %u producers x %u events: %llu delivered, %llu dropped (critical high water %u, normal %u)\n",
+                name, producers, perProducer, static_cast<unsigned long long>(received),
+                static_cast<unsigned long long>(dropped), stats.lanes[0].highWater, stats.lanes[1].highWater);
+    if (published + dropped != attempts || received != published || stats.dispatched != received ||
+        (paced && dropped != 0)) {
+        std::printf("LOST: %llu attempts, %llu published, %llu dropped, %llu delivered, %u dispatched\n",
+                    static_cast<unsigned long long>(attempts), static_cast<unsigned long long>(published),
+                    static_cast<unsigned long long>(dropped), static_cast<unsigned long long>(received),
+                    stats.dispatched);
+        return false;
+    }
+    return errors == 0;
+}
+bool runCoalesced(std::uint32_t count) {
+    Ev::clear();
+    Ev::resetStats();
+    std::atomic<bool> running{true};
+    std::thread producer([count, &running] {
+        for (std::uint32_t value = 1; value <= count; ++value) {
+            Ev::Event event{Ev::EventType::ObstacleAhead, value};
+            std::memcpy(event.payload, &value, sizeof(value));
+            Ev::publish(event);
+            if ((value & 0x0FU) == 0) {
+                std::this_thread::yield();
+            }
+        }
+        running.store(false, std::memory_order_release);
+    });
+
+    std::uint32_t last = 0;
+    std::uint64_t delivered = 0;
+    std::uint64_t errors = 0;
+    Ev::Event event{};
+    while (true) {
+        const bool done = !running.load(std::memory_order_acquire);
+        bool any = false;
+        while (Ev::poll(event)) {
+            any = true;
+            std::uint32_t value = 0;
+            std::memcpy(&value, event.payload, sizeof(value));
+            if ((value < last || value != event.timestampMs) && errors++ < 10) {
+                std::printf("coalesced value %u (stamp %u) after %u\n", value, event.timestampMs, last);
+            }
+            last = value;
+            ++delivered;
+        }
+        if (done && !any) {
+            break;
+        }
+    }
+    producer.join();
+
+    const Ev::LaneStats lane = Ev::stats().lanes[static_cast<std::size_t>(Ev::priorityOf(Ev::EventType::ObstacleAhead))];
+    std::printf("latest %u updates: %llu delivered, %u coalesced, %u dropped, last %u\n", count,
+                static_cast<unsigned long long>(delivered), lane.coalesced, lane.dropped, last);
+    if (last != count) {
+        std::printf("LOST UPDATE: final value %u never delivered\n", count);
+        return false;
+    }
+    return errors == 0;
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+    const std::uint32_t perProducer = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 20000;
+    const std::uint32_t producers = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 4;
+    if (producers == 0 || producers > 255 || perProducer == 0 || perProducer > 0x00FFFFFFU) {
+        std::printf("need 1-255 producers and 1-16777215 events each\n");
+        return 2;
+    }
+    const bool paced = run("paced", producers, perProducer, true);
+    const bool flood = run("flood", producers, perProducer, false);
+    const bool coalesced = runCoalesced(perProducer * producers);
+    return paced && flood && coalesced ? 0 : 1;
+}
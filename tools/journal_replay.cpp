@@ -0,0 +1,232 @@
+// Replays an incident journal downloaded from /api/journal through the firmware's RC
+// pipeline (signal-quality filter, calibration, staged failsafe) and checks that every
+// recorded drive packet comes out the same on the host.
+//
+// Build from the repo root:
+//   g++ -std=c++17 -O2 -I TankRC_Master tools/journal_replay.cpp TankRC_Master/channels/rc_calibration.cpp -o journal_replay
+// Run:
+//   ./journal_replay tankrc.journal [--verbose]
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+#include "comms/rc_pipeline.h"
+#include "diagnostics/journal_format.h"
+
+using namespace TankRC;
+namespace Journal = TankRC::Diagnostics::Journal;
+
+namespace {
+// The journal starts mid-stream, so the median windows and the link-quality history are
+// cold for the first polls; mismatches there are expected and reported separately.
+constexpr std::size_t kWarmupFrames = 64;
+// ESP32 and the host may fuse multiply-adds differently; allow for the last few bits.
+constexpr float kFloatTolerance = 1e-4F;
+
+struct Options {
+    const char* path = nullptr;
+    bool verbose = false;
+};
+
+const char* eventName(Events::EventType type) {
+    switch (type) {
+        case Events::EventType::DriveModeChanged:
+            return "drive-mode";
+        case Events::EventType::RcSignalLost:
+            return "rc-lost";
+        case Events::EventType::RcSignalRestored:
+            return "rc-restored";
+        case Events::EventType::LowBattery:
+            return "battery-low";
+        case Events::EventType::BatteryRecovered:
+            return "battery-recovered";
+        case Events::EventType::TipOverDetected:
+            return "tip-over";
+        case Events::EventType::ObstacleAhead:
+            return "obstacle";
+    }
+    return "?";
+}
+
+void printEvent(const Events::Event& event) {
+    std::printf("%10lu ms  event %-17s", static_cast<unsigned long>(event.timestampMs), eventName(event.type));
+    switch (event.type) {
+        case Events::EventType::DriveModeChanged:
+            std::printf(" mode=%ld", static_cast<long>(event.as<Events::DriveModeChanged>().mode));
+            break;
+        case Events::EventType::LowBattery:
+            std::printf(" %.2f V", event.as<Events::LowBattery>().voltage);
+            break;
+        case Events::EventType::BatteryRecovered:
+            std::printf(" %.2f V", event.as<Events::BatteryRecovered>().voltage);
+            break;
+        case Events::EventType::ObstacleAhead:
+            std::printf(" level=%.2f", event.as<Events::ObstacleAhead>().level);
+            break;
+        default:
+            break;
+    }
+    std::printf("\n");
+}
+
+bool sameDrive(const Journal::DriveRecord& a, const Journal::DriveRecord& b) {
+    return std::fabs(a.throttle - b.throttle) <= kFloatTolerance && std::fabs(a.turn - b.turn) <= kFloatTolerance &&
+           a.status == b.status && a.failsafe == b.failsafe && a.linkQuality == b.linkQuality && a.flags == b.flags;
+}
+
+void printDrive(const char* label, const Journal::DriveRecord& d) {
+    std::printf("    %-8s thr=%+.4f turn=%+.4f status=%u failsafe=%s quality=%u%% flags=%u\n",
+                label,
+                d.throttle,
+                d.turn,
+                d.status,
+                Channels::toString(static_cast<Channels::FailsafeStage>(d.failsafe)),
+                d.linkQuality,
+                d.flags);
+}
+
+template <std::size_t ChannelCount>
+int replay(const std::vector<std::uint8_t>& data, const Options& options) {
+    Comms::RcPipeline<ChannelCount> pipeline;
+    Drivers::RcFrame<ChannelCount> frame{};
+    Journal::DriveRecord produced{};
+    bool pending = false;
+    std::size_t frames = 0;
+    std::size_t compared = 0;
+    std::size_t mismatches = 0;
+    std::size_t warmupMismatches = 0;
+    std::size_t events = 0;
+    std::uint8_t lastStage = 0xFF;
+
+    std::size_t pos = Journal::kFileHeaderBytes;
+    while (pos + Journal::kRecordHeaderBytes <= data.size()) {
+        Journal::ByteReader header(&data[pos], Journal::kRecordHeaderBytes);
+        const auto type = static_cast<Journal::RecordType>(header.u8());
+        const std::size_t length = header.u8();
+        const std::uint32_t timeMs = header.u32();
+        pos += Journal::kRecordHeaderBytes;
+        if (pos + length > data.size()) {
+            std::fprintf(stderr, "truncated record at offset %zu\n", pos - Journal::kRecordHeaderBytes);
+            break;
+        }
+        const std::uint8_t* payload = &data[pos];
+        pos += length;
+
+        switch (type) {
+            case Journal::RecordType::RcConfig: {
+                Config::RcConfig config{};
+                if (Journal::decodeRcConfig(payload, length, config)) {
+                    pipeline.configure(config);
+                    std::printf("%10lu ms  rc config (hold %u ms, decelerate %u ms, stale %u ms)\n",
+                                static_cast<unsigned long>(timeMs),
+                                config.failsafe.holdMs,
+                                config.failsafe.decelerateMs,
+                                config.failsafe.staleMs);
+                }
+                break;
+            }
+            case Journal::RecordType::RcFrame: {
+                if (!Journal::decodeFrame(payload, length, frame)) {
+                    std::fprintf(stderr, "bad frame record at %lu ms\n", static_cast<unsigned long>(timeMs));
+                    break;
+                }
+                const Channels::LinkState link = pipeline.filter(frame, timeMs);
+                produced = Journal::toDriveRecord(pipeline.map(frame, link));
+                pending = true;
+                ++frames;
+                if (produced.failsafe != lastStage) {
+                    std::printf("%10lu ms  failsafe -> %s (quality %u%%)\n",
+                                static_cast<unsigned long>(timeMs),
+                                Channels::toString(link.stage),
+                                link.qualityPercent);
+                    lastStage = produced.failsafe;
+                }
+                break;
+            }
+            case Journal::RecordType::Drive: {
+                Journal::DriveRecord recorded{};
+                if (!pending || !Journal::decodeDrive(payload, length, recorded)) {
+                    break;
+                }
+                pending = false;
+                ++compared;
+                if (sameDrive(recorded, produced)) {
+                    break;
+                }
+                if (frames <= kWarmupFrames) {
+                    ++warmupMismatches;
+                    break;
+                }
+                ++mismatches;
+                if (options.verbose || mismatches <= 10) {
+                    std::printf("%10lu ms  MISMATCH\n", static_cast<unsigned long>(timeMs));
+                    printDrive("recorded", recorded);
+                    printDrive("replayed", produced);
+                }
+                break;
+            }
+            case Journal::RecordType::Event: {
+                Events::Event event{};
+                if (Journal::decodeEvent(payload, length, timeMs, event)) {
+                    printEvent(event);
+                    ++events;
+                }
+                break;
+            }
+            default:
+                if (options.verbose) {
+                    std::printf("%10lu ms  unknown record type %u\n", static_cast<unsigned long>(timeMs), static_cast<unsigned>(type));
+                }
+                break;
+        }
+    }
+
+    std::printf("\n%zu frames, %zu drive packets compared, %zu events\n", frames, compared, events);
+    std::printf("%zu mismatches (%zu more during the %zu-frame warm-up)\n", mismatches, warmupMismatches, kWarmupFrames);
+    return mismatches == 0 ? 0 : 1;
+}
+
+bool parseArgs(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--verbose") == 0) {
+            options.verbose = true;
+        } else if (!options.path) {
+            options.path = argv[i];
+        } else {
+            return false;
+        }
+    }
+    return options.path != nullptr;
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseArgs(argc, argv, options)) {
+        std::fprintf(stderr, "usage: %s <tankrc.journal> [--verbose]\n", argv[0]);
+        return 2;
+    }
+    std::ifstream in(options.path, std::ios::binary);
+    const std::vector<std::uint8_t> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    if (data.size() < Journal::kFileHeaderBytes || std::memcmp(data.data(), Journal::kMagic, sizeof(Journal::kMagic)) != 0) {
+        std::fprintf(stderr, "%s: not a TankRC journal\n", options.path);
+        return 2;
+    }
+    if (data[4] != Journal::kVersion) {
+        std::fprintf(stderr, "%s: journal version %u, this tool reads %u\n", options.path, data[4], Journal::kVersion);
+        return 2;
+    }
+    switch (data[5]) {
+        case 6:
+            return replay<6>(data, options);
+        case 16:
+            return replay<16>(data, options);
+        default:
+            std::fprintf(stderr, "%s: unsupported channel count %u\n", options.path, data[5]);
+            return 2;
+    }
+}
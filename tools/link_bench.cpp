@@ -0,0 +1,260 @@
+// Times the master<->slave frame parser on the host: the old byte-at-a-time state machine
+// with a bitwise CRC against the shared FrameCodec both firmwares use, reading from a
+// memory transport in UART-sized chunks. Both run over the same generated stream (a
+// realistic frame mix with line noise mixed in) and must agree on every frame and counter
+// before any timing is printed.
+//
+// Build from the repo root:
+//   g++ -std=c++17 -O2 -I TankRC_Master tools/link_bench.cpp -o link_bench
+// Run:
+//   ./link_bench [frames] [chunk bytes]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "../link/frame_codec.h"
+#include "memory_transport.h"
+
+using namespace TankRC::Comms;
+namespace SP = TankRC::Comms::SlaveProtocol;
+
+namespace {
+constexpr int kRounds = 20;
+
+struct Totals {
+    std::uint32_t frames = 0;
+    std::uint32_t payloadBytes = 0;
+    std::uint32_t checksum = 0;
+
+    void add(std::uint8_t type, std::uint8_t seq, std::uint8_t length, const std::uint8_t* payload) {
+        ++frames;
+        payloadBytes += length;
+        checksum = checksum * 31U + type * 7U + seq;
+        for (std::uint8_t i = 0; i < length; ++i) {
+            checksum = checksum * 31U + payload[i];
+        }
+    }
+
+    bool operator==(const Totals& other) const {
+        return frames == other.frames && payloadBytes == other.payloadBytes && checksum == other.checksum;
+    }
+};
+
+// Routes every frame type the stream carries into Totals, in arrival order.
+struct Sink {
+    const SP::FrameCodec<MemoryTransport>* codec = nullptr;
+    Totals totals{};
+
+    template <SP::FrameType Type>
+    void record(const std::uint8_t* payload, std::uint8_t length) {
+        totals.add(static_cast<std::uint8_t>(Type), codec->rxSeq(), length, payload);
+    }
+
+    using Routes = SP::FrameTable<SP::OnBytes<SP::FrameType::CompactCommand, &Sink::record<SP::FrameType::CompactCommand>>,
+                                  SP::OnBytes<SP::FrameType::Status, &Sink::record<SP::FrameType::Status>>,
+                                  SP::OnBytes<SP::FrameType::Telemetry, &Sink::record<SP::FrameType::Telemetry>>,
+                                  SP::OnBytes<SP::FrameType::Perf, &Sink::record<SP::FrameType::Perf>>>;
+};
+
+// The parser both endpoints used before bulk reads, kept verbatim apart from the frame
+// sink: one switch step and one bitwise CRC update per received byte.
+class LegacyParser {
+  public:
+    void processByte(std::uint8_t byte, SP::LinkCounters& counters, Totals& totals) {
+        switch (state_) {
+            case State::Magic:
+                if (byte == SP::kMagic) {
+                    hunting_ = false;
+                    state_ = State::Type;
+                } else if (!hunting_) {
+                    hunting_ = true;
+                    ++counters.resyncs;
+                }
+                break;
+            case State::Type:
+                type_ = byte;
+                crc_ = crc16Bitwise(SP::kCrcInit, byte);
+                state_ = State::Seq;
+                break;
+            case State::Seq:
+                seq_ = byte;
+                crc_ = crc16Bitwise(crc_, byte);
+                length_ = SP::fixedLength(type_);
+                pos_ = 0;
+                state_ = length_ > 0 ? State::Payload : State::Length;
+                break;
+            case State::Length:
+                length_ = byte;
+                pos_ = 0;
+                crc_ = crc16Bitwise(crc_, byte);
+                if (length_ > payload_.size()) {
+                    state_ = State::Magic;
+                } else if (length_ == 0) {
+                    state_ = State::CrcLow;
+                } else {
+                    state_ = State::Payload;
+                }
+                break;
+            case State::Payload:
+                payload_[pos_++] = byte;
+                crc_ = crc16Bitwise(crc_, byte);
+                if (pos_ >= length_) {
+                    state_ = State::CrcLow;
+                }
+                break;
+            case State::CrcLow:
+                crcLow_ = byte;
+                state_ = State::CrcHigh;
+                break;
+            case State::CrcHigh:
+                if (crc_ == static_cast<std::uint16_t>(crcLow_ | (byte << 8))) {
+                    totals.add(type_, seq_, length_, payload_.data());
+                } else {
+                    ++counters.crcErrors;
+                }
+                state_ = State::Magic;
+                break;
+        }
+    }
+
+  private:
+    enum class State { Magic, Type, Seq, Length, Payload, CrcLow, CrcHigh };
+
+    static std::uint16_t crc16Bitwise(std::uint16_t crc, std::uint8_t byte) {
+        crc ^= static_cast<std::uint16_t>(byte) << 8;
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc & 0x8000U) ? static_cast<std::uint16_t>((crc << 1) ^ 0x1021U) : static_cast<std::uint16_t>(crc << 1);
+        }
+        return crc;
+    }
+
+    State state_ = State::Magic;
+    bool hunting_ = false;
+    std::uint8_t type_ = 0;
+    std::uint8_t seq_ = 0;
+    std::uint8_t length_ = 0;
+    std::uint8_t pos_ = 0;
+    std::uint16_t crc_ = 0;
+    std::uint8_t crcLow_ = 0;
+    std::array<std::uint8_t, SP::kMaxPayload> payload_{};
+};
+
+void appendFrame(std::vector<std::uint8_t>& out, SP::FrameType type, std::uint8_t seq, const std::vector<std::uint8_t>& payload) {
+    const auto length = static_cast<std::uint8_t>(payload.size());
+    const std::uint16_t crc = SP::crc16(type, seq, length, payload.data());
+    out.push_back(SP::kMagic);
+    out.push_back(static_cast<std::uint8_t>(type));
+    out.push_back(seq);
+    if (SP::fixedLength(static_cast<std::uint8_t>(type)) == 0) {
+        out.push_back(length);
+    }
+    out.insert(out.end(), payload.begin(), payload.end());
+    out.push_back(static_cast<std::uint8_t>(crc & 0xFFU));
+    out.push_back(static_cast<std::uint8_t>(crc >> 8));
+}
+
+// Mostly compact commands, as the master streams them, with status, telemetry and perf
+// frames from the slave side and the occasional burst of noise or corrupted byte.
+std::vector<std::uint8_t> makeStream(std::size_t frames) {
+    std::mt19937 rng(1234);
+    std::vector<std::uint8_t> out;
+    std::uint8_t seq = 0;
+    for (std::size_t i = 0; i < frames; ++i) {
+        SP::FrameType type = SP::FrameType::CompactCommand;
+        std::size_t length = sizeof(SP::CompactCommandPayload);
+        switch (rng() % 10) {
+            case 0:
+                type = SP::FrameType::Status;
+                length = sizeof(SP::StatusPayload);
+                break;
+            case 1:
+                type = SP::FrameType::Telemetry;
+                length = 8 + rng() % (SP::kMaxPayload - 8);
+                break;
+            case 2:
+                type = SP::FrameType::Perf;
+                length = sizeof(SP::PerfPayload);
+                break;
+            default:
+                break;
+        }
+        std::vector<std::uint8_t> payload(length);
+        for (auto& byte : payload) {
+            byte = static_cast<std::uint8_t>(rng());
+        }
+        const std::size_t start = out.size();
+        appendFrame(out, type, seq++, payload);
+        if (rng() % 200 == 0) {
+            out[start + 3 + rng() % (out.size() - start - 3)] ^= 0x40;
+        }
+        if (rng() % 100 == 0) {
+            for (std::size_t n = rng() % 12; n > 0; --n) {
+                out.push_back(static_cast<std::uint8_t>(rng()));
+            }
+        }
+    }
+    return out;
+}
+
+template <typename Fn>
+double bestNs(Fn&& fn) {
+    double best = 1e30;
+    for (int round = 0; round < kRounds; ++round) {
+        const auto start = std::chrono::steady_clock::now();
+        fn();
+        const auto end = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double, std::nano>(end - start).count());
+    }
+    return best;
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t frames = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 200000;
+    const std::size_t chunk = argc > 2 ? std::max<std::size_t>(std::strtoul(argv[2], nullptr, 10), 1) : 64;
+    const std::vector<std::uint8_t> stream = makeStream(frames);
+
+    Totals legacyTotals{};
+    SP::LinkCounters legacyCounters{};
+    const double legacyNs = bestNs([&] {
+        LegacyParser parser;
+        legacyTotals = {};
+        legacyCounters = {};
+        for (const std::uint8_t byte : stream) {
+            parser.processByte(byte, legacyCounters, legacyTotals);
+        }
+    });
+
+    Totals codecTotals{};
+    SP::LinkCounters codecCounters{};
+    MemoryTransport transport;
+    transport.maxRead = chunk;
+    const double codecNs = bestNs([&] {
+        transport.load(stream);
+        SP::FrameCodec<MemoryTransport> codec(&transport);
+        Sink sink;
+        sink.codec = &codec;
+        codec.receive<Sink::Routes>(sink);
+        codecTotals = sink.totals;
+        codecCounters = codec.rxCounters();
+    });
+
+    if (!(legacyTotals == codecTotals) || legacyCounters.crcErrors != codecCounters.crcErrors ||
+        legacyCounters.resyncs != codecCounters.resyncs) {
+        std::printf("MISMATCH: legacy %u frames / %u crc / %u resync, codec %u frames / %u crc / %u resync\n",
+                    legacyTotals.frames, legacyCounters.crcErrors, legacyCounters.resyncs, codecTotals.frames,
+                    codecCounters.crcErrors, codecCounters.resyncs);
+        return 1;
+    }
+
+    std::printf("%zu bytes, %u frames (%u payload bytes), %u crc errors, %u resyncs, %zu-byte reads\n", stream.size(),
+                codecTotals.frames, codecTotals.payloadBytes, codecCounters.crcErrors, codecCounters.resyncs, chunk);
+    std::printf("%-10s %10s %10s\n", "parser", "ns/byte", "ns/frame");
+    std::printf("%-10s %10.2f %10.1f\n", "per-byte", legacyNs / stream.size(), legacyNs / codecTotals.frames);
+    std::printf("%-10s %10.2f %10.1f\n", "codec", codecNs / stream.size(), codecNs / codecTotals.frames);
+    std::printf("speedup    %9.2fx\n", legacyNs / codecNs);
+    return 0;
+}
@@ -0,0 +1,41 @@
+#pragma once
+#ifndef TANKRC_TOOLS_MEMORY_TRANSPORT_H
+#define TANKRC_TOOLS_MEMORY_TRANSPORT_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// Host stand-in for HardwareSerial in SlaveProtocol::FrameCodec: write() appends to `tx`,
+// read() hands out `rx` at most `maxRead` bytes at a time, like a UART driver that only
+// has part of the stream buffered.
+struct MemoryTransport {
+    std::vector<std::uint8_t> rx;
+    std::vector<std::uint8_t> tx;
+    std::size_t rxPos = 0;
+    std::size_t maxRead = 64;
+
+    void load(const std::vector<std::uint8_t>& bytes) {
+        rx = bytes;
+        rxPos = 0;
+    }
+
+    int available() const {
+        return static_cast<int>(std::min(rx.size() - rxPos, maxRead));
+    }
+
+    std::size_t read(std::uint8_t* buffer, std::size_t size) {
+        const std::size_t count = std::min({size, rx.size() - rxPos, maxRead});
+        std::memcpy(buffer, rx.data() + rxPos, count);
+        rxPos += count;
+        return count;
+    }
+
+    std::size_t write(const std::uint8_t* data, std::size_t size) {
+        tx.insert(tx.end(), data, data + size);
+        return size;
+    }
+};
+#endif  // TANKRC_TOOLS_MEMORY_TRANSPORT_H
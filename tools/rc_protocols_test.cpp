@@ -0,0 +1,263 @@
+// Feeds the SBUS, iBUS and CRSF decoders byte streams laid out the way the receivers send
+// them: a good frame, a corrupted checksum/CRC, the failsafe/frame-lost signalling each
+// protocol has, and frames split across reads with line noise in front.
+//
+// Build from the repo root:
+//   g++ -std=c++17 -O1 -g -fsanitize=address,undefined -I TankRC_Master tools/rc_protocols_test.cpp -o rc_protocols_test
+// Run:
+//   ./rc_protocols_test
+
+#include <cstdio>
+#include <initializer_list>
+#include <vector>
+
+#include "drivers/rc_protocols.h"
+
+namespace RP = TankRC::Drivers::RcProtocols;
+
+namespace {
+using Bytes = std::vector<std::uint8_t>;
+
+int failures = 0;
+
+void check(bool ok, const char* what) {
+    if (!ok) {
+        std::printf("FAIL: %s\n", what);
+        ++failures;
+    }
+}
+
+// Inverse of ticksToUs() for the values used below.
+constexpr std::uint16_t usToTicks(std::uint16_t us) {
+    return static_cast<std::uint16_t>(((us - 880U) * 8U) / 5U);
+}
+
+void pack11(const std::uint16_t* ticks, std::size_t count, std::uint8_t* out) {
+    std::uint32_t bits = 0;
+    int bitCount = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        bits |= static_cast<std::uint32_t>(ticks[i] & 0x07FFU) << bitCount;
+        bitCount += 11;
+        while (bitCount >= 8) {
+            *out++ = static_cast<std::uint8_t>(bits & 0xFFU);
+            bits >>= 8;
+            bitCount -= 8;
+        }
+    }
+}
+
+// Channel i at 1000 + 50 * i µs, all inside the 11-bit tick range.
+std::uint16_t expectedUs(std::size_t channel) {
+    return static_cast<std::uint16_t>(1000U + 50U * channel);
+}
+
+Bytes sbusFrame(std::uint8_t flags, std::uint8_t footer = 0x00) {
+    std::uint16_t ticks[RP::SbusDecoder::kChannelCount]{};
+    for (std::size_t i = 0; i < RP::SbusDecoder::kChannelCount; ++i) {
+        ticks[i] = usToTicks(expectedUs(i));
+    }
+    Bytes frame(25, 0);
+    frame[0] = 0x0F;
+    pack11(ticks, RP::SbusDecoder::kChannelCount, &frame[1]);
+    frame[23] = flags;
+    frame[24] = footer;
+    return frame;
+}
+
+Bytes ibusFrame() {
+    Bytes frame{0x20, 0x40};
+    for (std::size_t i = 0; i < RP::IbusDecoder::kChannelCount; ++i) {
+        const std::uint16_t us = expectedUs(i);
+        frame.push_back(static_cast<std::uint8_t>(us & 0xFFU));
+        frame.push_back(static_cast<std::uint8_t>(us >> 8));
+    }
+    std::uint16_t sum = 0xFFFF;
+    for (const std::uint8_t byte : frame) {
+        sum = static_cast<std::uint16_t>(sum - byte);
+    }
+    frame.push_back(static_cast<std::uint8_t>(sum & 0xFFU));
+    frame.push_back(static_cast<std::uint8_t>(sum >> 8));
+    return frame;
+}
+
+std::uint8_t crc8DvbS2(const std::uint8_t* data, std::size_t length) {
+    std::uint8_t crc = 0;
+    for (std::size_t i = 0; i < length; ++i) {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc & 0x80U) ? static_cast<std::uint8_t>((crc << 1) ^ 0xD5U) : static_cast<std::uint8_t>(crc << 1);
+        }
+    }
+    return crc;
+}
+
+Bytes crsfFrame(std::uint8_t type, const Bytes& payload) {
+    Bytes frame{0xC8, static_cast<std::uint8_t>(payload.size() + 2), type};
+    frame.insert(frame.end(), payload.begin(), payload.end());
+    frame.push_back(crc8DvbS2(&frame[2], payload.size() + 1));
+    return frame;
+}
+
+Bytes crsfChannels() {
+    std::uint16_t ticks[RP::CrsfDecoder::kChannelCount]{};
+    for (std::size_t i = 0; i < RP::CrsfDecoder::kChannelCount; ++i) {
+        ticks[i] = usToTicks(expectedUs(i));
+    }
+    Bytes payload(22, 0);
+    pack11(ticks, RP::CrsfDecoder::kChannelCount, payload.data());
+    return crsfFrame(0x16, payload);
+}
+
+// Pushes `bytes` in reads of `chunk` bytes, as a UART driver would hand them over, and
+// returns how many frames the decoder latched.
+template <typename Decoder>
+int feed(Decoder& decoder, const Bytes& bytes, std::size_t chunk = 1) {
+    int latched = 0;
+    for (std::size_t start = 0; start < bytes.size(); start += chunk) {
+        for (std::size_t i = start; i < bytes.size() && i < start + chunk; ++i) {
+            latched += decoder.push(bytes[i]) ? 1 : 0;
+        }
+    }
+    return latched;
+}
+
+template <typename Decoder>
+bool channelsMatch(const Decoder& decoder) {
+    for (std::size_t i = 0; i < Decoder::kChannelCount; ++i) {
+        const int diff = static_cast<int>(decoder.channelsUs()[i]) - static_cast<int>(expectedUs(i));
+        // SBUS/CRSF ticks are 0.625 µs; the round trip may lose one.
+        if (diff < -1 || diff > 1) {
+            std::printf("  channel %zu: %u us, expected %u\n", i, decoder.channelsUs()[i], expectedUs(i));
+            return false;
+        }
+    }
+    return true;
+}
+
+Bytes concat(std::initializer_list<Bytes> parts) {
+    Bytes out;
+    for (const auto& part : parts) {
+        out.insert(out.end(), part.begin(), part.end());
+    }
+    return out;
+}
+
+void testSbus() {
+    {
+        RP::SbusDecoder decoder;
+        check(feed(decoder, sbusFrame(0x00)) == 1, "sbus: good frame latched");
+        check(channelsMatch(decoder), "sbus: good frame channels");
+        check(!decoder.failsafe() && !decoder.frameLost(), "sbus: good frame flags clear");
+        check(feed(decoder, sbusFrame(0x00, 0x14)) == 1, "sbus: SBUS2 footer accepted");
+    }
+    {
+        RP::SbusDecoder decoder;
+        check(feed(decoder, sbusFrame(0x00, 0x55)) == 0, "sbus: bad footer rejected");
+        check(decoder.errors() == 1 && decoder.frames() == 0, "sbus: bad footer counted");
+        check(feed(decoder, sbusFrame(0x00)) == 1, "sbus: recovers after bad footer");
+    }
+    {
+        RP::SbusDecoder decoder;
+        check(feed(decoder, sbusFrame(1U << 2)) == 1 && decoder.frameLost() && !decoder.failsafe(),
+              "sbus: frame-lost flag");
+        check(feed(decoder, sbusFrame((1U << 2) | (1U << 3))) == 1 && decoder.failsafe(), "sbus: failsafe flag");
+        check(feed(decoder, sbusFrame(0x00)) == 1 && !decoder.failsafe() && !decoder.frameLost(),
+              "sbus: flags clear again");
+    }
+    {
+        RP::SbusDecoder decoder;
+        const Bytes stream = concat({Bytes{0x00, 0xAA, 0x31}, sbusFrame(0x00), sbusFrame(0x00)});
+        check(feed(decoder, stream, 7) == 2, "sbus: frames split across 7-byte reads");
+        check(channelsMatch(decoder), "sbus: split frame channels");
+    }
+}
+
+void testIbus() {
+    {
+        // Literal frame, all 14 channels at 1500 µs, with a hand-computed checksum.
+        Bytes captured{0x20, 0x40};
+        for (int i = 0; i < 14; ++i) {
+            captured.push_back(0xDC);
+            captured.push_back(0x05);
+        }
+        captured.push_back(0x51);
+        captured.push_back(0xF3);
+        RP::IbusDecoder decoder;
+        check(feed(decoder, captured) == 1 && decoder.channelsUs()[0] == 1500 && decoder.channelsUs()[13] == 1500,
+              "ibus: captured frame");
+    }
+    {
+        RP::IbusDecoder decoder;
+        check(feed(decoder, ibusFrame()) == 1, "ibus: good frame latched");
+        check(channelsMatch(decoder), "ibus: good frame channels");
+        check(!decoder.failsafe(), "ibus: no failsafe flag");
+    }
+    {
+        RP::IbusDecoder decoder;
+        Bytes frame = ibusFrame();
+        frame[10] ^= 0x01;
+        check(feed(decoder, frame) == 0, "ibus: bad checksum rejected");
+        check(decoder.errors() == 1 && decoder.frames() == 0, "ibus: bad checksum counted");
+        check(feed(decoder, ibusFrame()) == 1, "ibus: recovers after bad checksum");
+    }
+    {
+        // iBUS has no flag: a receiver in failsafe stops sending, so a lost link means no
+        // new frames and the last values stay latched.
+        RP::IbusDecoder decoder;
+        feed(decoder, ibusFrame());
+        const Bytes frame = ibusFrame();
+        const Bytes truncated(frame.begin(), frame.begin() + 12);
+        check(feed(decoder, truncated) == 0 && decoder.frames() == 1 && channelsMatch(decoder),
+              "ibus: frame lost mid-transfer latches nothing");
+    }
+    {
+        RP::IbusDecoder decoder;
+        // A stray 0x20 that is not followed by the command byte must not swallow the header.
+        const Bytes stream = concat({Bytes{0x20, 0x20}, ibusFrame(), ibusFrame()});
+        check(feed(decoder, stream, 5) == 2, "ibus: frames split across 5-byte reads");
+        check(channelsMatch(decoder), "ibus: split frame channels");
+    }
+}
+
+void testCrsf() {
+    {
+        RP::CrsfDecoder decoder;
+        check(feed(decoder, crsfChannels()) == 1, "crsf: good frame latched");
+        check(channelsMatch(decoder), "crsf: good frame channels");
+    }
+    {
+        RP::CrsfDecoder decoder;
+        Bytes frame = crsfChannels();
+        frame.back() ^= 0x80;
+        check(feed(decoder, frame) == 0, "crsf: bad crc rejected");
+        check(decoder.errors() == 1 && decoder.frames() == 0, "crsf: bad crc counted");
+        check(feed(decoder, crsfChannels()) == 1, "crsf: recovers after bad crc");
+    }
+    {
+        // CRSF carries link loss in LINK_STATISTICS (0x14), not in the channel frame; the
+        // decoder skips it without latching or counting an error.
+        RP::CrsfDecoder decoder;
+        const Bytes linkStats = crsfFrame(0x14, Bytes{0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00});
+        check(feed(decoder, linkStats) == 0 && decoder.frames() == 0 && decoder.errors() == 0,
+              "crsf: link statistics frame skipped");
+        check(!decoder.failsafe(), "crsf: no failsafe flag");
+    }
+    {
+        RP::CrsfDecoder decoder;
+        // 0xC8 followed by an impossible length must resync onto the real frame.
+        const Bytes stream = concat({Bytes{0xC8, 0xFF, 0x12}, crsfChannels(), crsfChannels()});
+        check(feed(decoder, stream, 3) == 2, "crsf: frames split across 3-byte reads");
+        check(channelsMatch(decoder), "crsf: split frame channels");
+    }
+}
+}  // namespace
+
+int main() {
+    testSbus();
+    testIbus();
+    testCrsf();
+    if (failures == 0) {
+        std::printf("rc protocols: all checks passed\n");
+    }
+    return failures == 0 ? 0 : 1;
+}
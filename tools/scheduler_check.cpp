@@ -0,0 +1,165 @@
+// Simulates core 1 of the master: the control task at priority 3 runs the scheduler's task
+// table and sleeps between deadlines, and anything below it (the Arduino loop task with the
+// console, IDLE1) only runs while it is blocked. Each task takes a fixed fraction of its
+// budget. The sleep follows planSleep() the way Scheduler::sleepUntilNext() does, next to
+// the old policy that spun every sub-tick remainder. The check fails if lower-priority
+// tasks go a whole loop period without CPU time, or if blocking makes any task start later
+// than spinning did by more than the timer wake-up.
+//
+// Build from the repo root:
+//   g++ -std=c++17 -O2 -I . tools/scheduler_check.cpp -o scheduler_check
+// Run:
+//   ./scheduler_check [load percent of budget] [simulated seconds]
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+#include <vector>
+
+#include "../scheduler/scheduler.h"
+
+namespace Sch = TankRC::Scheduler;
+
+namespace {
+struct SimTask {
+    const char* name;
+    std::uint32_t periodUs;
+    std::uint8_t priority;
+    std::uint32_t budgetUs;
+};
+
+// Mirrors kTasks in TankRC_Master.ino.
+constexpr SimTask kTasks[] = {
+    {"inputs", 5000, 4, 1000},
+    {"control", 5000, 3, 1000},
+    {"slave link", 1000, 2, 300},
+    {"outputs", 5000, 1, 1000},
+    {"housekeeping", 100000, 0, 5000},
+};
+constexpr std::uint32_t kMaxIdleSleepUs = 5000;
+// loop() polls every kUiPollMs; it needs some CPU in every window of that length.
+constexpr std::uint64_t kLoopWindowUs = 20000;
+// esp_timer dispatch to a notified task, generously.
+constexpr std::uint64_t kTimerWakeUs = 30;
+
+struct Result {
+    std::uint64_t busyUs = 0;
+    std::uint64_t spunUs = 0;
+    std::uint64_t blockedUs = 0;
+    std::uint64_t minWindowFreeUs = 0;
+    std::uint64_t maxLateUs = 0;
+};
+
+Result simulate(bool spinSubTick, std::uint32_t loadPercent, std::uint64_t durationUs) {
+    std::vector<std::uint64_t> deadline(std::size(kTasks), 0);
+    Result result{};
+    result.minWindowFreeUs = kLoopWindowUs;
+    std::uint64_t now = 0;
+    std::uint64_t windowStart = 0;
+    std::uint64_t windowFree = 0;
+
+    auto advance = [&](std::uint64_t us, bool blocked) {
+        while (us > 0) {
+            const std::uint64_t step = std::min(us, windowStart + kLoopWindowUs - now);
+            now += step;
+            us -= step;
+            if (blocked) {
+                windowFree += step;
+            }
+            if (now == windowStart + kLoopWindowUs) {
+                result.minWindowFreeUs = std::min(result.minWindowFreeUs, windowFree);
+                windowStart = now;
+                windowFree = 0;
+            }
+        }
+    };
+
+    while (now < durationUs) {
+        // runDue(): highest priority first among the tasks that are due.
+        while (true) {
+            std::size_t best = std::size(kTasks);
+            for (std::size_t i = 0; i < std::size(kTasks); ++i) {
+                if (deadline[i] <= now && (best == std::size(kTasks) || kTasks[i].priority > kTasks[best].priority)) {
+                    best = i;
+                }
+            }
+            if (best == std::size(kTasks)) {
+                break;
+            }
+            result.maxLateUs = std::max(result.maxLateUs, now - deadline[best]);
+            const std::uint64_t execUs = kTasks[best].budgetUs * loadPercent / 100U;
+            advance(execUs, false);
+            result.busyUs += execUs;
+            deadline[best] += kTasks[best].periodUs;
+            while (deadline[best] < now) {
+                deadline[best] += kTasks[best].periodUs;
+            }
+        }
+
+        // sleepUntilNext()
+        const std::uint64_t next = *std::min_element(deadline.begin(), deadline.end());
+        const auto wait = static_cast<std::uint32_t>(std::min<std::uint64_t>(next - now, kMaxIdleSleepUs));
+        const std::uint64_t target = now + wait;
+        const Sch::SleepPlan plan = Sch::planSleep(wait);
+        if (plan.ticks > 0) {
+            // vTaskDelay(n) returns on the n-th tick interrupt, so it never overshoots.
+            const std::uint64_t wake = (now / Sch::kTickUs + plan.ticks) * Sch::kTickUs;
+            result.blockedUs += wake - now;
+            advance(wake - now, true);
+        }
+        if (now >= target) {
+            continue;
+        }
+        const std::uint64_t rest = target - now;
+        if (!spinSubTick && rest > Sch::kMaxSpinUs) {
+            result.blockedUs += rest;
+            advance(rest, true);
+            advance(kTimerWakeUs, false);  // counts as late start for whatever is due
+        } else {
+            result.spunUs += rest;
+            advance(rest, false);
+        }
+    }
+    return result;
+}
+
+void report(const char* name, const Result& result, std::uint64_t durationUs) {
+    std::printf("%-14s busy %5.1f%%  spun %5.1f%%  free for lower priorities %5.1f%%  "
+                "min free per %llu ms %6llu us  max late %llu us\n",
+                name, 100.0 * result.busyUs / durationUs, 100.0 * result.spunUs / durationUs,
+                100.0 * result.blockedUs / durationUs, static_cast<unsigned long long>(kLoopWindowUs / 1000U),
+                static_cast<unsigned long long>(result.minWindowFreeUs),
+                static_cast<unsigned long long>(result.maxLateUs));
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+    const std::uint32_t loadPercent = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 50;
+    const std::uint32_t seconds = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 10;
+    if (loadPercent == 0 || loadPercent > 100 || seconds == 0) {
+        std::printf("need a load of 1-100 percent and at least one second\n");
+        return 2;
+    }
+    const std::uint64_t durationUs = static_cast<std::uint64_t>(seconds) * 1000000U;
+
+    const Result spinning = simulate(true, loadPercent, durationUs);
+    const Result timer = simulate(false, loadPercent, durationUs);
+    report("spin sub-tick", spinning, durationUs);
+    report("timer wake", timer, durationUs);
+
+    bool ok = true;
+    if (timer.minWindowFreeUs == 0) {
+        std::printf("STARVED: a %llu ms window passed with no time for lower-priority tasks\n",
+                    static_cast<unsigned long long>(kLoopWindowUs / 1000U));
+        ok = false;
+    }
+    // Tasks queue behind each other either way; blocking may only add the timer wake-up.
+    if (timer.maxLateUs > spinning.maxLateUs + kTimerWakeUs) {
+        std::printf("LATE: a task started %llu us after its deadline, %llu us when spinning\n",
+                    static_cast<unsigned long long>(timer.maxLateUs),
+                    static_cast<unsigned long long>(spinning.maxLateUs));
+        ok = false;
+    }
+    return ok ? 0 : 1;
+}